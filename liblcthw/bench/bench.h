@@ -0,0 +1,136 @@
+#ifndef _bench_h
+#define _bench_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+static inline double bench_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// peak resident set size of this process in KB
+static inline long bench_maxrss()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// xorshift so every run and every machine sees the same inputs
+static inline unsigned int bench_rand(unsigned int *state)
+{
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static inline int bench_cmp_int(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+#define bench_report(NAME, N, SECS) printf("%-36s n=%-9d %10.3f ms %9.1f ns/op\n",\
+        (NAME), (N), (SECS) * 1e3, (SECS) * 1e9 / (N))
+
+enum { BENCH_RANDOM, BENCH_SORTED, BENCH_REVERSED, BENCH_FEW_SWAPS,
+    BENCH_NUM_INPUTS };
+
+static const char *const bench_input_names[] = { "random", "sorted", "reversed",
+    "few-swaps" };
+
+// fills values with one of the input distributions, same for every run
+static inline void bench_fill(int *values, int n, int input)
+{
+    unsigned int seed = 42;
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        values[i] = input == BENCH_REVERSED ? n - i :
+            input == BENCH_RANDOM ? (int)bench_rand(&seed) : i;
+    }
+
+    if (input == BENCH_FEW_SWAPS) {
+        // 1% of the elements end up out of place
+        for (i = 0; i < n / 100; i++) {
+            int a = bench_rand(&seed) % n;
+            int b = bench_rand(&seed) % n;
+            int tmp = values[a];
+            values[a] = values[b];
+            values[b] = tmp;
+        }
+    }
+}
+
+typedef struct BenchStats {
+    double median;
+    double p99;
+    double min;
+} BenchStats;
+
+static inline int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Times reps runs of fn after warmup untimed ones. setup and teardown
+ * run around every run, outside the timer, and can be NULL.
+ */
+static inline BenchStats bench_measure(void (*setup) (void *ctx),
+        void (*fn) (void *ctx), void (*teardown) (void *ctx), void *ctx,
+        int warmup, int reps)
+{
+    BenchStats stats = { 0, 0, 0 };
+    double *times = calloc(reps, sizeof(double));
+    int i = 0;
+
+    if (times == NULL || reps < 1) {
+        free(times);
+        return stats;
+    }
+
+    for (i = -warmup; i < reps; i++) {
+        if (setup) setup(ctx);
+
+        double start = bench_now();
+        fn(ctx);
+        double elapsed = bench_now() - start;
+
+        if (teardown) teardown(ctx);
+        if (i >= 0) times[i] = elapsed;
+    }
+
+    qsort(times, reps, sizeof(double), bench_cmp_double);
+
+    stats.min = times[0];
+    stats.median = reps % 2 ? times[reps / 2] :
+        (times[reps / 2 - 1] + times[reps / 2]) / 2;
+    // nearest rank, with few reps this is the slowest run
+    stats.p99 = times[(int)(0.99 * (reps - 1) + 0.5)];
+
+    free(times);
+    return stats;
+}
+
+#define BENCH_CSV_HEADER "benchmark,input,n,reps,median_ns_per_op,p99_ns_per_op,min_ns_per_op\n"
+
+static inline void bench_csv(const char *name, const char *input, int n,
+        int reps, BenchStats stats)
+{
+    printf("%s,%s,%d,%d,%.2f,%.2f,%.2f\n", name, input, n, reps,
+            stats.median * 1e9 / n, stats.p99 * 1e9 / n, stats.min * 1e9 / n);
+    fflush(stdout);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "bench.h"
+#include <lcthw/clist.h>
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+enum { BASELINE, LIST, LIST_POOLED, CLIST, CLIST_COPY, NUM_KINDS };
+
+static const char *const kind_names[] = { "baseline", "List", "pooled List",
+    "CList", "CList + copy" };
+
+// builds one container of n values and scans it, in this process
+static void build(int kind, int n)
+{
+    char name[64];
+    uintptr_t sum = 0;
+    int i = 0;
+
+    double start = bench_now();
+
+    if (kind == LIST || kind == LIST_POOLED) {
+        List *list = kind == LIST ? List_create() : List_create_pooled(65536);
+        for (i = 0; i < n; i++) {
+            List_push(list, (void *)(uintptr_t)i);
+        }
+        snprintf(name, sizeof(name), "%s push", kind_names[kind]);
+        bench_report(name, n, bench_now() - start);
+
+        start = bench_now();
+        LIST_FOREACH(list, first, next, cur) {
+            sum += (uintptr_t)cur->value;
+        }
+        snprintf(name, sizeof(name), "%s scan", kind_names[kind]);
+        bench_report(name, n, bench_now() - start);
+    } else if (kind == CLIST || kind == CLIST_COPY) {
+        CList *list = CList_create();
+        for (i = 0; i < n; i++) {
+            CList_push(list, (void *)(uintptr_t)i);
+        }
+        bench_report("CList push", n, bench_now() - start);
+
+        start = bench_now();
+        CLIST_FOREACH(list, first, next, cur) {
+            sum += (uintptr_t)cur->value;
+        }
+        bench_report("CList scan", n, bench_now() - start);
+
+        if (kind == CLIST_COPY) {
+            start = bench_now();
+            CList *copy = CList_copy(list);
+            bench_report("CList_copy", n, bench_now() - start);
+            CList_destroy(copy);
+        }
+    }
+
+    // the lists are left for exit to clean up, freeing 10^7 nodes isn't the point
+    if (sum == 1) printf("\n");
+    fflush(stdout);
+}
+
+// peak RSS of a child that builds kind, so every kind starts from nothing
+static long measure(int kind, int n)
+{
+    struct rusage usage;
+    int status = 0;
+
+    // or the child prints whatever the parent still has buffered
+    fflush(stdout);
+    pid_t pid = fork();
+    check(pid >= 0, "Failed to fork.");
+
+    if (pid == 0) {
+        build(kind, n);
+        exit(0);
+    }
+
+    check(wait4(pid, &status, 0, &usage) == pid, "Failed to wait.");
+    return usage.ru_maxrss;
+
+error:
+    return -1;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    long base = measure(BASELINE, n);
+    int kind = 0;
+
+    for (kind = LIST; kind < NUM_KINDS; kind++) {
+        long rss = measure(kind, n);
+        printf("%-36s %8.1f MB %6.1f bytes/element\n", kind_names[kind],
+                (rss - base) / 1024.0, (rss - base) * 1024.0 / n);
+    }
+
+    return 0;
+}
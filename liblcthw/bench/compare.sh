@@ -0,0 +1,44 @@
+# Compares two list_bench CSV files and flags every benchmark whose
+# median got slower by more than BENCH_THRESHOLD percent (default 10).
+#
+#     sh bench/compare.sh baseline.csv results.csv
+
+BASELINE=$1
+RESULTS=$2
+THRESHOLD=${BENCH_THRESHOLD:-10}
+
+if [ ! -f "$BASELINE" ] || [ ! -f "$RESULTS" ]
+then
+    echo "USAGE: compare.sh baseline.csv results.csv"
+    exit 2
+fi
+
+awk -F, -v threshold="$THRESHOLD" '
+    FNR == 1 { next }
+    NR == FNR { base[$1 "," $2 "," $3] = $5; next }
+    {
+        key = $1 "," $2 "," $3
+        if (!(key in base) || base[key] <= 0) {
+            printf("%-52s %10s %10.2f  new\n", key, "-", $5)
+            next
+        }
+
+        change = ($5 - base[key]) * 100 / base[key]
+        flag = ""
+        if (change > threshold) {
+            flag = "REGRESSION"
+            regressions++
+        } else if (change < -threshold) {
+            flag = "faster"
+        }
+
+        printf("%-52s %10.2f %10.2f %+7.1f%% %s\n", key, base[key], $5,
+                change, flag)
+    }
+    END {
+        if (regressions > 0) {
+            printf("\n%d regression(s) over %s%%\n", regressions, threshold)
+            exit 1
+        }
+    }
+' "$BASELINE" "$RESULTS"
@@ -0,0 +1,90 @@
+#include "bench.h"
+#include <lcthw/hashmap.h>
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define KEY_SIZE 16
+
+static void *list_lookup(List * list, const char *key)
+{
+    LIST_FOREACH(list, first, next, cur) {
+        if (strcmp(cur->value, key) == 0) {
+            return cur->value;
+        }
+    }
+
+    return NULL;
+}
+
+static void run(int n)
+{
+    char name[64];
+    unsigned int seed = 42;
+    double worst = 0;
+    int lookups = 1000000;
+    // a List lookup is a full scan, so only do a few of those
+    int list_lookups = n <= 10000 ? 1000 : 20;
+    int i = 0;
+
+    Hashmap *map = NULL;
+    List *list = NULL;
+    char *keys = malloc((size_t)n * KEY_SIZE);
+    check_mem(keys);
+
+    for (i = 0; i < n; i++) {
+        snprintf(&keys[(size_t)i * KEY_SIZE], KEY_SIZE, "key-%u", i);
+    }
+
+    map = Hashmap_create(NULL, NULL);
+    list = List_create();
+    check(map != NULL && list != NULL, "Failed to create containers.");
+
+    double start = bench_now();
+    for (i = 0; i < n; i++) {
+        double one = bench_now();
+        Hashmap_set(map, &keys[(size_t)i * KEY_SIZE], &keys[(size_t)i * KEY_SIZE]);
+        one = bench_now() - one;
+        if (one > worst) worst = one;
+    }
+    bench_report("Hashmap_set", n, bench_now() - start);
+    printf("%-36s worst single set %.1f us\n", "Hashmap_set", worst * 1e6);
+
+    for (i = 0; i < n; i++) {
+        List_push(list, &keys[(size_t)i * KEY_SIZE]);
+    }
+
+    start = bench_now();
+    for (i = 0; i < lookups; i++) {
+        char *key = &keys[(size_t)(bench_rand(&seed) % n) * KEY_SIZE];
+        check(Hashmap_get(map, key) == key, "Hashmap lost %s", key);
+    }
+    snprintf(name, sizeof(name), "Hashmap_get n=%d", n);
+    bench_report(name, lookups, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < list_lookups; i++) {
+        char *key = &keys[(size_t)(bench_rand(&seed) % n) * KEY_SIZE];
+        check(list_lookup(list, key) == key, "List lost %s", key);
+    }
+    snprintf(name, sizeof(name), "List lookup n=%d", n);
+    bench_report(name, list_lookups, bench_now() - start);
+
+error:          // fallthrough
+    Hashmap_destroy(map);
+    if (list) List_destroy(list);
+    free(keys);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 10000000;
+    int n = 0;
+
+    for (n = 1000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
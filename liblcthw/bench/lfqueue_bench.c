@@ -0,0 +1,110 @@
+#include "bench.h"
+#include <lcthw/lfqueue.h>
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+static int ops_per_producer = 0;
+static atomic_int consumed = 0;
+static int total = 0;
+static int use_mutex = 0;
+
+static LFQueue *queue = NULL;
+static List *list = NULL;
+static pthread_mutex_t list_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static char value[] = "value";
+
+static void *producer(void *arg)
+{
+    int i = 0;
+    (void)arg;
+
+    for (i = 0; i < ops_per_producer; i++) {
+        if (use_mutex) {
+            pthread_mutex_lock(&list_lock);
+            List_push(list, value);
+            pthread_mutex_unlock(&list_lock);
+        } else {
+            LFQueue_push(queue, value);
+        }
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    void *got = NULL;
+    (void)arg;
+
+    while (atomic_load(&consumed) < total) {
+        if (use_mutex) {
+            pthread_mutex_lock(&list_lock);
+            got = List_shift(list);
+            pthread_mutex_unlock(&list_lock);
+        } else {
+            got = LFQueue_shift(queue);
+        }
+
+        if (got != NULL) {
+            atomic_fetch_add(&consumed, 1);
+        }
+    }
+
+    return NULL;
+}
+
+static void run(int mutex, int threads, int n)
+{
+    pthread_t producers[64];
+    pthread_t consumers[64];
+    char name[64];
+    int i = 0;
+
+    use_mutex = mutex;
+    ops_per_producer = n / threads;
+    total = ops_per_producer * threads;
+    atomic_store(&consumed, 0);
+
+    double start = bench_now();
+
+    for (i = 0; i < threads; i++) {
+        pthread_create(&consumers[i], NULL, consumer, NULL);
+        pthread_create(&producers[i], NULL, producer, NULL);
+    }
+
+    for (i = 0; i < threads; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    snprintf(name, sizeof(name), "%s %dP/%dC", mutex ? "mutex List" : "LFQueue",
+            threads, threads);
+    // one push and one shift per value
+    bench_report(name, total * 2, bench_now() - start);
+}
+
+int main(int argc, char *argv[])
+{
+    int threads[] = { 1, 2, 4, 8 };
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int i = 0;
+
+    queue = LFQueue_create();
+    list = List_create();
+    check(queue != NULL && list != NULL, "Failed to create queues.");
+
+    for (i = 0; i < 4; i++) {
+        run(1, threads[i], n);
+        run(0, threads[i], n);
+    }
+
+    LFQueue_destroy(queue);
+    List_destroy(list);
+    return 0;
+
+error:
+    return 1;
+}
@@ -0,0 +1,482 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/list_sort.h>
+#include <lcthw/darray.h>
+#include <lcthw/threadpool.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * The suite behind make bench: the List operations and sorts in list.h
+ * and list_algos.h at several sizes and input distributions, as CSV on
+ * stdout. ListMerge is timed through List_merge_many, and creating and
+ * clearing lists only as part of other rows. New List operations get a case here so there's one baseline
+ * for all of them, the other *_bench programs are one-off comparisons
+ * against alternatives and other structures. Every row is ns per value,
+ * the O(1) operations are run n times so that's ns per call.
+ *
+ *     list_bench [max_n] [reps]
+ */
+
+LIST_DEFINE_SORT(List_sort_int, int *, LIST_CMP_INT)
+
+// what List_merge_many gets, round robin so each is an n / MERGE_LISTS slice
+#define MERGE_LISTS 8
+#define STR_SIZE 12
+
+typedef struct Ctx {
+    int n;
+    int *values;
+    // the same values as pointers, for List_push_many
+    void **ptrs;
+    // values printed as strings, for the string sorts
+    char (*strs)[STR_SIZE];
+    List *list;
+    List *lists[MERGE_LISTS];
+    ListNode *middle;
+    ThreadPool *pool;
+} Ctx;
+
+static uint64_t int_key(const void *value)
+{
+    // flip the sign bit so negative ints sort first
+    return (uint64_t)(int64_t)*(const int *)value ^ (1ULL << 63);
+}
+
+static const char *str_key(const void *value)
+{
+    return value;
+}
+
+static void make_empty(void *arg)
+{
+    Ctx *ctx = arg;
+    ctx->list = List_create();
+}
+
+static void make_full(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    ctx->list = List_create();
+    for (i = 0; i < ctx->n; i++) {
+        List_push(ctx->list, &ctx->values[i]);
+    }
+}
+
+static void make_pooled(void *arg)
+{
+    Ctx *ctx = arg;
+    ctx->list = List_create_pooled(4096);
+}
+
+static void make_full_middle(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    make_full(arg);
+    for (ctx->middle = ctx->list->first, i = 0; i < ctx->n / 2; i++) {
+        ctx->middle = ctx->middle->next;
+    }
+}
+
+// hex of the value with the sign flipped, so it sorts like the int
+static void fill_strs(Ctx * ctx)
+{
+    int i = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        snprintf(ctx->strs[i], STR_SIZE, "%08x",
+                (unsigned int)ctx->values[i] ^ 0x80000000u);
+    }
+}
+
+static void make_full_str(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    ctx->list = List_create();
+    for (i = 0; i < ctx->n; i++) {
+        List_push(ctx->list, ctx->strs[i]);
+    }
+}
+
+static void make_sorted_lists(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    for (i = 0; i < MERGE_LISTS; i++) {
+        ctx->lists[i] = List_create();
+    }
+    for (i = 0; i < ctx->n; i++) {
+        List_push(ctx->lists[i % MERGE_LISTS], &ctx->values[i]);
+    }
+    for (i = 0; i < MERGE_LISTS; i++) {
+        List_merge_sort(ctx->lists[i], bench_cmp_int);
+    }
+}
+
+static void destroy(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    List_destroy(ctx->list);
+    ctx->list = NULL;
+
+    for (i = 0; i < MERGE_LISTS; i++) {
+        if (ctx->lists[i]) List_destroy(ctx->lists[i]);
+        ctx->lists[i] = NULL;
+    }
+}
+
+static void run_push(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        List_push(ctx->list, &ctx->values[i]);
+    }
+}
+
+static void run_push_pooled(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    // creating the list is part of the cost of pooling, so it's timed
+    ctx->list = List_create_pooled(4096);
+    for (i = 0; i < ctx->n; i++) {
+        List_push(ctx->list, &ctx->values[i]);
+    }
+}
+
+static void run_unshift(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    for (i = 0; i < ctx->n; i++) {
+        List_unshift(ctx->list, &ctx->values[i]);
+    }
+}
+
+static void run_pop(void *arg)
+{
+    Ctx *ctx = arg;
+    while (List_pop(ctx->list) != NULL) {
+    }
+}
+
+static void run_shift(void *arg)
+{
+    Ctx *ctx = arg;
+    while (List_shift(ctx->list) != NULL) {
+    }
+}
+
+static void run_remove(void *arg)
+{
+    Ctx *ctx = arg;
+
+    // always the second node, an unlink with neighbours on both sides
+    while (List_count(ctx->list) > 2) {
+        List_remove(ctx->list, ctx->list->first->next);
+    }
+}
+
+static volatile uintptr_t sink = 0;
+
+static void run_foreach(void *arg)
+{
+    Ctx *ctx = arg;
+    uintptr_t sum = 0;
+
+    LIST_FOREACH(ctx->list, first, next, cur) {
+        sum += (uintptr_t)cur->value;
+    }
+
+    sink = sum;
+}
+
+static void run_push_many(void *arg)
+{
+    Ctx *ctx = arg;
+    List_push_many(ctx->list, ctx->ptrs, ctx->n);
+}
+
+static void run_split_join(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    // given the count both are O(1), and the join puts middle back
+    for (i = 0; i < ctx->n; i++) {
+        List *tail = List_split_at(ctx->list, ctx->middle,
+                ctx->n - ctx->n / 2);
+        List_join(ctx->list, tail);
+        List_destroy(tail);
+    }
+}
+
+static void run_splice(void *arg)
+{
+    Ctx *ctx = arg;
+    int i = 0;
+
+    // rotates the last node round to the front, one O(1) splice each
+    for (i = 0; i < ctx->n; i++) {
+        List_splice(ctx->list, ctx->list->first, ctx->list, ctx->list->last,
+                ctx->list->last, 1);
+    }
+}
+
+static void run_merge_many(void *arg)
+{
+    Ctx *ctx = arg;
+    ctx->list = List_merge_many(ctx->lists, MERGE_LISTS, bench_cmp_int);
+}
+
+static void visit_sum(void *value, void *arg)
+{
+    *(uintptr_t *)arg += (uintptr_t)value;
+}
+
+static void *map_same(void *value, void *arg)
+{
+    (void)arg;
+    return value;
+}
+
+static void chunk_sum(ListNode ** nodes, int n, void *arg)
+{
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        *(uintptr_t *)arg += (uintptr_t)nodes[i]->value;
+    }
+}
+
+static void run_foreach_batch(void *arg)
+{
+    Ctx *ctx = arg;
+    uintptr_t sum = 0;
+
+    List_foreach_batch(ctx->list, visit_sum, &sum);
+    sink = sum;
+}
+
+static void run_map(void *arg)
+{
+    Ctx *ctx = arg;
+    List_map(ctx->list, map_same, NULL);
+}
+
+static void run_foreach_chunked(void *arg)
+{
+    Ctx *ctx = arg;
+    uintptr_t sum = 0;
+
+    List_foreach_chunked(ctx->list, chunk_sum, &sum);
+    sink = sum;
+}
+
+static void *reduce_sum(void *acc, void *value, void *arg)
+{
+    (void)arg;
+    return (void *)((uintptr_t)acc + (uintptr_t)*(int *)value);
+}
+
+static void *combine_sum(void *acc, void *value, void *arg)
+{
+    (void)arg;
+    return (void *)((uintptr_t)acc + (uintptr_t)value);
+}
+
+static void run_parallel_reduce(void *arg)
+{
+    Ctx *ctx = arg;
+    sink = (uintptr_t)List_parallel_reduce(ctx->pool, ctx->list, NULL,
+            reduce_sum, combine_sum, NULL);
+}
+
+static void run_parallel_map(void *arg)
+{
+    Ctx *ctx = arg;
+    List_parallel_map(ctx->pool, ctx->list, map_same, NULL);
+}
+
+static void run_top_k(void *arg)
+{
+    Ctx *ctx = arg;
+    DArray_destroy(List_top_k(ctx->list, 100, bench_cmp_int));
+}
+
+static void run_nth_element(void *arg)
+{
+    Ctx *ctx = arg;
+    List_nth_element(ctx->list, ctx->n / 2, bench_cmp_int);
+}
+
+static void run_bubble_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_bubble_sort(ctx->list, bench_cmp_int);
+}
+
+static void run_merge_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_merge_sort(ctx->list, bench_cmp_int);
+}
+
+static void run_tim_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_tim_sort(ctx->list, bench_cmp_int);
+}
+
+static void run_radix_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_radix_sort(ctx->list, int_key);
+}
+
+static void run_parallel_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_parallel_sort(ctx->list, bench_cmp_int, 4);
+}
+
+static void run_cached_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_cached_sort(ctx->list, int_key, bench_cmp_int);
+}
+
+static void run_radix_sort_str(void *arg)
+{
+    Ctx *ctx = arg;
+    List_radix_sort_str(ctx->list, str_key);
+}
+
+static void run_cached_sort_str(void *arg)
+{
+    Ctx *ctx = arg;
+    List_cached_sort_str(ctx->list, str_key);
+}
+
+static void run_define_sort(void *arg)
+{
+    Ctx *ctx = arg;
+    List_sort_int(ctx->list);
+}
+
+typedef struct BenchCase {
+    const char *name;
+    void (*setup) (void *ctx);
+    void (*fn) (void *ctx);
+    // sorts run once per input distribution, the rest on random only
+    int per_input;
+    // quadratic cases are skipped above this size
+    int max_n;
+} BenchCase;
+
+static BenchCase cases[] = {
+    {"List_push", make_empty, run_push, 0, 0},
+    {"List_push_pooled", NULL, run_push_pooled, 0, 0},
+    {"List_unshift", make_empty, run_unshift, 0, 0},
+    {"List_pop", make_full, run_pop, 0, 0},
+    {"List_shift", make_full, run_shift, 0, 0},
+    {"List_remove", make_full, run_remove, 0, 0},
+    {"LIST_FOREACH", make_full, run_foreach, 0, 0},
+    {"List_push_many", make_pooled, run_push_many, 0, 0},
+    {"List_split_at+List_join", make_full_middle, run_split_join, 0, 0},
+    {"List_splice", make_full, run_splice, 0, 0},
+    {"List_foreach_batch", make_full, run_foreach_batch, 0, 0},
+    {"List_map", make_full, run_map, 0, 0},
+    {"List_foreach_chunked", make_full, run_foreach_chunked, 0, 0},
+    {"List_parallel_map", make_full, run_parallel_map, 0, 0},
+    {"List_parallel_reduce", make_full, run_parallel_reduce, 0, 0},
+    {"List_top_k", make_full, run_top_k, 1, 0},
+    {"List_nth_element", make_full, run_nth_element, 1, 0},
+    {"List_merge_many", make_sorted_lists, run_merge_many, 1, 0},
+    {"List_bubble_sort", make_full, run_bubble_sort, 1, 10000},
+    {"List_merge_sort", make_full, run_merge_sort, 1, 0},
+    {"List_tim_sort", make_full, run_tim_sort, 1, 0},
+    {"List_radix_sort", make_full, run_radix_sort, 1, 0},
+    {"List_parallel_sort", make_full, run_parallel_sort, 1, 0},
+    {"List_radix_sort_str", make_full_str, run_radix_sort_str, 1, 0},
+    {"List_cached_sort", make_full, run_cached_sort, 1, 0},
+    {"List_cached_sort_str", make_full_str, run_cached_sort_str, 1, 0},
+    {"LIST_DEFINE_SORT", make_full, run_define_sort, 1, 0},
+    {NULL, NULL, NULL, 0, 0}
+};
+
+int main(int argc, char *argv[])
+{
+    int max_n = argc > 1 ? atoi(argv[1]) : 100000;
+    int reps = argc > 2 ? atoi(argv[2]) : 11;
+    Ctx ctx = { 0 };
+    int n = 0;
+    int input = 0;
+    BenchCase *c = NULL;
+
+    check(max_n > 0 && reps > 0, "USAGE: list_bench [max_n] [reps]");
+
+    ctx.values = malloc(max_n * sizeof(int));
+    check_mem(ctx.values);
+    ctx.ptrs = malloc(max_n * sizeof(void *));
+    check_mem(ctx.ptrs);
+    ctx.strs = malloc(max_n * sizeof(*ctx.strs));
+    check_mem(ctx.strs);
+    ctx.pool = ThreadPool_create(4);
+    check(ctx.pool != NULL, "Failed to start the thread pool.");
+
+    for (n = 0; n < max_n; n++) {
+        ctx.ptrs[n] = &ctx.values[n];
+    }
+
+    printf(BENCH_CSV_HEADER);
+
+    for (n = 1000; n <= max_n; n *= 10) {
+        ctx.n = n;
+
+        for (c = cases; c->name != NULL; c++) {
+            if (c->max_n > 0 && n > c->max_n) {
+                continue;
+            }
+
+            for (input = 0; input < (c->per_input ? BENCH_NUM_INPUTS : 1);
+                    input++) {
+                bench_fill(ctx.values, n, input);
+                if (c->setup == make_full_str) {
+                    fill_strs(&ctx);
+                }
+                BenchStats stats = bench_measure(c->setup, c->fn, destroy,
+                        &ctx, 2, reps);
+                bench_csv(c->name, bench_input_names[input], n, reps, stats);
+            }
+        }
+    }
+
+    ThreadPool_destroy(ctx.pool);
+    free(ctx.strs);
+    free(ctx.ptrs);
+    free(ctx.values);
+    return 0;
+
+error:
+    ThreadPool_destroy(ctx.pool);
+    free(ctx.strs);
+    free(ctx.ptrs);
+    free(ctx.values);
+    return 1;
+}
@@ -0,0 +1,90 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PATH_SIZE 64
+
+static const char *str_key(const void *value)
+{
+    return value;
+}
+
+// the first 8 bytes, which is all a plain key can hold
+static uint64_t prefix_key(const void *value)
+{
+    const unsigned char *str = value;
+    uint64_t key = 0;
+    int i = 0;
+
+    for (i = 0; i < 8 && str[i] != '\0'; i++) {
+        key |= (uint64_t)str[i] << (56 - 8 * i);
+    }
+
+    return key;
+}
+
+// log paths: 30 or so bytes in common before they differ at all
+static List *path_list(char *paths, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        unsigned int r = bench_rand(&seed);
+        snprintf(&paths[i * PATH_SIZE], PATH_SIZE,
+                "/var/log/services/ingest-%02u/2024-05-%02u/worker-%06u.log",
+                r % 4, (r >> 2) % 28 + 1, (r >> 7) % 1000000);
+        List_push(list, &paths[i * PATH_SIZE]);
+    }
+
+    return list;
+}
+
+static void run(int n)
+{
+    char *paths = malloc((size_t)n * PATH_SIZE);
+    check_mem(paths);
+
+    List *list = path_list(paths, n);
+    double start = bench_now();
+    List_merge_sort(list, (List_compare) strcmp);
+    bench_report("paths List_merge_sort strcmp", n, bench_now() - start);
+    List_destroy(list);
+
+    list = path_list(paths, n);
+    start = bench_now();
+    List_radix_sort_str(list, str_key);
+    bench_report("paths List_radix_sort_str", n, bench_now() - start);
+    List_destroy(list);
+
+    list = path_list(paths, n);
+    start = bench_now();
+    List_cached_sort(list, prefix_key, (List_compare) strcmp);
+    bench_report("paths List_cached_sort 8B+strcmp", n, bench_now() - start);
+    List_destroy(list);
+
+    list = path_list(paths, n);
+    start = bench_now();
+    List_cached_sort_str(list, str_key);
+    bench_report("paths List_cached_sort_str", n, bench_now() - start);
+    List_destroy(list);
+
+error:          // fallthrough
+    free(paths);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 1000000;
+    int n = 0;
+
+    for (n = 10000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
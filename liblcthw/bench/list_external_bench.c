@@ -0,0 +1,118 @@
+#include "bench.h"
+#include <lcthw/list_external.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+typedef struct Record {
+    int key;
+    int payload[3];
+} Record;
+
+typedef struct Source {
+    unsigned int seed;
+    int left;
+} Source;
+
+typedef struct Sink {
+    int last;
+    long count;
+    int sorted;
+} Sink;
+
+static int cmp_record(const void *a, const void *b)
+{
+    return bench_cmp_int(&((const Record *)a)->key, &((const Record *)b)->key);
+}
+
+static int write_record(const void *rec, FILE * out)
+{
+    return fwrite(rec, sizeof(Record), 1, out) == 1 ? 0 : -1;
+}
+
+static void *read_record(FILE * in)
+{
+    Record *rec = malloc(sizeof(Record));
+
+    if (rec != NULL && fread(rec, sizeof(Record), 1, in) != 1) {
+        free(rec);
+        return NULL;
+    }
+
+    return rec;
+}
+
+static size_t size_record(const void *value)
+{
+    (void)value;
+    return sizeof(Record);
+}
+
+// makes the records as they're asked for, so the input never sits in memory
+static void *next_record(void *ctx)
+{
+    Source *source = ctx;
+    Record *rec = NULL;
+
+    if (source->left-- <= 0) {
+        return NULL;
+    }
+
+    rec = calloc(1, sizeof(Record));
+    rec->key = bench_rand(&source->seed) & 0x7fffffff;
+    return rec;
+}
+
+static int check_record(void *value, void *ctx)
+{
+    Sink *sink = ctx;
+    Record *rec = value;
+
+    if (rec->key < sink->last) sink->sorted = 0;
+    sink->last = rec->key;
+    sink->count++;
+    free(rec);
+
+    return 0;
+}
+
+static void run(size_t cap, int times, int fan_in)
+{
+    char name[64];
+    size_t per_value = sizeof(ListNode) + sizeof(Record);
+    int n = cap * times / per_value;
+    Source source = { 42, n };
+    Sink sink = { 0, 0, 1 };
+    ListExternal ext = {.cmp = cmp_record,.write = write_record,
+        .read = read_record,.size = size_record,.free_value = free,
+        .mem_cap = cap,.fan_in = fan_in
+    };
+
+    double start = bench_now();
+    int rc = List_external_sort(&ext, next_record, &source, check_record, &sink);
+    double secs = bench_now() - start;
+    check(rc == 0 && sink.sorted && sink.count == n, "External sort failed.");
+
+    snprintf(name, sizeof(name), "List_external_sort %dx cap fan_in=%d",
+            times, fan_in);
+    bench_report(name, n, secs);
+    printf("%-36s runs %d, passes %d, spilled %.1f MB, runs %.3f s, "
+            "merge %.3f s, maxrss %ld KB\n", "", ext.stats.runs,
+            ext.stats.passes, ext.stats.bytes_spilled / 1048576.0,
+            ext.stats.run_secs, ext.stats.merge_secs, bench_maxrss());
+
+error:          // fallthrough
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t cap = (argc > 1 ? atoi(argv[1]) : 16) * 1024 * 1024;
+
+    printf("%-36s %zu MB\n", "memory cap", cap / 1048576);
+    run(cap, 4, 16);
+    run(cap, 16, 16);
+    // a small fan in forces a pass through the disk in between
+    run(cap, 16, 4);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+// the pairwise way: each merge copies into a fresh list
+static List *copying_merge(List * left, List * right, List_compare cmp)
+{
+    List *result = List_create();
+
+    while (List_count(left) > 0 || List_count(right) > 0) {
+        if (List_count(right) == 0 || (List_count(left) > 0 &&
+                    cmp(List_first(left), List_first(right)) <= 0)) {
+            List_push(result, List_shift(left));
+        } else {
+            List_push(result, List_shift(right));
+        }
+    }
+
+    return result;
+}
+
+// deals values round robin so every shard covers the whole range
+static void make_shards(List ** lists, int k, int *values, int n)
+{
+    int i = 0;
+
+    for (i = 0; i < k; i++) {
+        lists[i] = List_create();
+    }
+
+    for (i = 0; i < n; i++) {
+        List_push(lists[i % k], &values[i]);
+    }
+
+    for (i = 0; i < k; i++) {
+        List_merge_sort(lists[i], bench_cmp_int);
+    }
+}
+
+static void destroy_shards(List ** lists, int k)
+{
+    int i = 0;
+
+    for (i = 0; i < k; i++) {
+        List_destroy(lists[i]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int ks[] = { 4, 16, 64, 256 };
+    List *lists[256];
+    char name[64];
+    long sum = 0;
+    int i = 0;
+    int j = 0;
+
+    int *values = malloc(n * sizeof(int));
+    check_mem(values);
+    bench_fill(values, n, BENCH_RANDOM);
+
+    for (i = 0; i < (int)(sizeof(ks) / sizeof(ks[0])); i++) {
+        int k = ks[i];
+
+        make_shards(lists, k, values, n);
+        double start = bench_now();
+        List *merged = List_create();
+        for (j = 0; j < k; j++) {
+            List *next = copying_merge(merged, lists[j], bench_cmp_int);
+            List_destroy(merged);
+            merged = next;
+        }
+        snprintf(name, sizeof(name), "pairwise copying merge k=%d", k);
+        bench_report(name, n, bench_now() - start);
+        List_destroy(merged);
+        destroy_shards(lists, k);
+
+        make_shards(lists, k, values, n);
+        start = bench_now();
+        merged = List_merge_many(lists, k, bench_cmp_int);
+        snprintf(name, sizeof(name), "List_merge_many k=%d", k);
+        bench_report(name, n, bench_now() - start);
+        List_destroy(merged);
+        destroy_shards(lists, k);
+
+        make_shards(lists, k, values, n);
+        start = bench_now();
+        ListMerge *merge = ListMerge_create(lists, k, bench_cmp_int);
+        ListNode *node = NULL;
+        while ((node = ListMerge_next(merge)) != NULL) {
+            sum += *(int *)node->value;
+        }
+        ListMerge_destroy(merge);
+        snprintf(name, sizeof(name), "ListMerge_next k=%d", k);
+        bench_report(name, n, bench_now() - start);
+        destroy_shards(lists, k);
+    }
+
+    printf("%-36s checksum %ld\n", "", sum);
+    free(values);
+    return 0;
+
+error:
+    return 1;
+}
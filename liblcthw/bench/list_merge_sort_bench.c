@@ -0,0 +1,115 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+/*
+ * The List_merge_sort that shipped before the in-place version, kept
+ * here only to measure against.
+ */
+static List *copying_merge(List * left, List * right, List_compare cmp)
+{
+    List *result = List_create();
+    void *val = NULL;
+
+    while (List_count(left) > 0 || List_count(right) > 0) {
+        if (List_count(left) > 0 && List_count(right) > 0) {
+            if (cmp(List_first(left), List_first(right)) <= 0) {
+                val = List_shift(left);
+            } else {
+                val = List_shift(right);
+            }
+        } else if (List_count(left) > 0) {
+            val = List_shift(left);
+        } else {
+            val = List_shift(right);
+        }
+
+        List_push(result, val);
+    }
+
+    return result;
+}
+
+static List *copying_merge_sort(List * list, List_compare cmp)
+{
+    List *result = NULL;
+
+    if (List_count(list) <= 1) {
+        return list;
+    }
+
+    List *left = List_create();
+    List *right = List_create();
+    int middle = List_count(list) / 2;
+
+    LIST_FOREACH(list, first, next, cur) {
+        if (middle > 0) {
+            List_push(left, cur->value);
+        } else {
+            List_push(right, cur->value);
+        }
+
+        middle--;
+    }
+
+    List *sort_left = copying_merge_sort(left, cmp);
+    List *sort_right = copying_merge_sort(right, cmp);
+
+    if (sort_left != left)
+        List_destroy(left);
+    if (sort_right != right)
+        List_destroy(right);
+
+    result = copying_merge(sort_left, sort_right, cmp);
+
+    List_destroy(sort_left);
+    List_destroy(sort_right);
+
+    return result;
+}
+
+static List *random_list(int *values, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create();
+
+    for (i = 0; i < n; i++) {
+        values[i] = bench_rand(&seed);
+        List_push(list, &values[i]);
+    }
+
+    return list;
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 10000000;
+    int n = 0;
+
+    for (n = 1000; n <= max; n *= 10) {
+        int *values = malloc(n * sizeof(int));
+        check_mem(values);
+
+        List *list = random_list(values, n);
+        double start = bench_now();
+        List *sorted = copying_merge_sort(list, bench_cmp_int);
+        bench_report("copying List_merge_sort", n, bench_now() - start);
+        if (sorted != list) List_destroy(sorted);
+        List_destroy(list);
+
+        list = random_list(values, n);
+        start = bench_now();
+        List_merge_sort(list, bench_cmp_int);
+        bench_report("in-place List_merge_sort", n, bench_now() - start);
+        List_destroy(list);
+
+        free(values);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
@@ -0,0 +1,54 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+static List *random_list(int *values, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    // pooled so every run starts from the same fresh node layout
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        values[i] = bench_rand(&seed);
+        List_push(list, &values[i]);
+    }
+
+    return list;
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[] = { 1000000, 10000000 };
+    int threads[] = { 1, 2, 4, 8, 16, 32 };
+    int max = argc > 1 ? atoi(argv[1]) : 10000000;
+    char name[64];
+    int i = 0;
+    int t = 0;
+
+    for (i = 0; i < 2 && sizes[i] <= max; i++) {
+        int n = sizes[i];
+        int *values = malloc(n * sizeof(int));
+        check_mem(values);
+
+        for (t = 0; t < 6; t++) {
+            List *list = random_list(values, n);
+
+            double start = bench_now();
+            List_parallel_sort(list, bench_cmp_int, threads[t]);
+            snprintf(name, sizeof(name), "List_parallel_sort threads=%d",
+                    threads[t]);
+            bench_report(name, n, bench_now() - start);
+
+            List_destroy(list);
+        }
+
+        free(values);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
@@ -0,0 +1,73 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define BLOCK_SIZE 4096
+
+static char value[] = "value";
+
+/*
+ * Queue workload: fill to n, churn n push/shift pairs, then drain.
+ * Runs in a child so every mode reports its own peak RSS.
+ */
+static void run_queue(const char *name, int pooled, int n)
+{
+    int i = 0;
+    pid_t pid = fork();
+    check(pid >= 0, "Failed to fork for %s.", name);
+
+    if (pid == 0) {
+        List *list = pooled ? List_create_pooled(BLOCK_SIZE) : List_create();
+        check_mem(list);
+
+        double start = bench_now();
+
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+        }
+
+        for (i = 0; i < n; i++) {
+            List_push(list, value);
+            List_shift(list);
+        }
+
+        for (i = 0; i < n; i++) {
+            List_shift(list);
+        }
+
+        double elapsed = bench_now() - start;
+        // 4 list operations per element
+        bench_report(name, n * 4, elapsed);
+        printf("%-36s maxrss=%ld KB\n", name, bench_maxrss());
+
+        List_destroy(list);
+        exit(0);
+    }
+
+    waitpid(pid, NULL, 0);
+
+error:
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[] = { 100000, 1000000, 4000000 };
+    int n = argc > 1 ? atoi(argv[1]) : 0;
+    int i = 0;
+
+    for (i = 0; i < 3; i++) {
+        int size = n > 0 ? n : sizes[i];
+
+        run_queue("push/shift calloc", 0, size);
+        run_queue("push/shift pooled", 1, size);
+
+        if (n > 0) break;
+    }
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// enough to push every earlier list and value out of the last level cache
+#define EVICT_SIZE (64 * 1024 * 1024)
+
+static void add_value(void *value, void *ctx)
+{
+    *(long *)ctx += *(int *)value;
+}
+
+// a callback with some work of its own, about what a hash lookup costs
+static inline int mix(int value)
+{
+    unsigned int x = (unsigned int)value | 1;
+    int i = 0;
+
+    for (i = 0; i < 16; i++) {
+        x = x * 2654435761u + (x >> 13);
+    }
+
+    // x never hits 0 on these inputs, the sum check would say, but the
+    // compiler has to do the work to know that
+    return value + (x == 0);
+}
+
+static void add_mixed(void *value, void *ctx)
+{
+    *(long *)ctx += mix(*(int *)value);
+}
+
+static void add_chunk(ListNode ** nodes, int n, void *ctx)
+{
+    long sum = 0;
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        sum += *(int *)nodes[i]->value;
+    }
+
+    *(long *)ctx += sum;
+}
+
+static void *bump_value(void *value, void *ctx)
+{
+    (void)ctx;
+    (*(int *)value)++;
+    return value;
+}
+
+/*
+ * n nodes and n values, each its own malloc. The values are always
+ * handed out in a random order, and with shuffle_nodes the nodes are
+ * linked in one too, so neither is anywhere near the one before.
+ */
+static List *scattered_list(int n, int shuffle_nodes)
+{
+    ListNode **nodes = malloc(n * sizeof(ListNode *));
+    List *list = List_create();
+    unsigned int seed = 42;
+    int i = 0;
+
+    check_mem(nodes);
+
+    for (i = 0; i < n; i++) {
+        int *value = malloc(sizeof(int));
+        check_mem(value);
+        *value = i;
+        List_push(list, value);
+    }
+
+    i = 0;
+    LIST_FOREACH(list, first, next, cur) {
+        nodes[i++] = cur;
+    }
+
+    for (i = n - 1; shuffle_nodes && i > 0; i--) {
+        int j = bench_rand(&seed) % (i + 1);
+        ListNode *tmp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = tmp;
+    }
+
+    // and the values too, so value order has nothing to do with node order
+    for (i = n - 1; i > 0; i--) {
+        int j = bench_rand(&seed) % (i + 1);
+        void *tmp = nodes[i]->value;
+        nodes[i]->value = nodes[j]->value;
+        nodes[j]->value = tmp;
+    }
+
+    for (i = 0; i < n; i++) {
+        nodes[i]->prev = i > 0 ? nodes[i - 1] : NULL;
+        nodes[i]->next = i < n - 1 ? nodes[i + 1] : NULL;
+    }
+
+    list->first = nodes[0];
+    list->last = nodes[n - 1];
+
+error:          // fallthrough
+    free(nodes);
+    return list;
+}
+
+static void evict(char *junk)
+{
+    int i = 0;
+
+    for (i = 0; i < EVICT_SIZE; i += 64) {
+        junk[i]++;
+    }
+}
+
+enum { MACRO, BATCH, CHUNKED, MACRO_MIXED, BATCH_MIXED, MACRO_MAP, MAP,
+    NUM_WALKS };
+
+static const char *const walk_names[] = { "LIST_FOREACH sum",
+    "foreach_batch sum", "foreach_chunked sum", "LIST_FOREACH mixed sum",
+    "foreach_batch mixed sum", "LIST_FOREACH incr", "List_map incr" };
+
+static long walk(List * list, int kind)
+{
+    long sum = 0;
+
+    if (kind == MACRO) {
+        LIST_FOREACH(list, first, next, cur) {
+            sum += *(int *)cur->value;
+        }
+    } else if (kind == BATCH) {
+        List_foreach_batch(list, add_value, &sum);
+    } else if (kind == CHUNKED) {
+        List_foreach_chunked(list, add_chunk, &sum);
+    } else if (kind == MACRO_MIXED) {
+        LIST_FOREACH(list, first, next, cur) {
+            add_mixed(cur->value, &sum);
+        }
+    } else if (kind == BATCH_MIXED) {
+        List_foreach_batch(list, add_mixed, &sum);
+    } else if (kind == MACRO_MAP) {
+        LIST_FOREACH(list, first, next, cur) {
+            cur->value = bump_value(cur->value, NULL);
+        }
+    } else {
+        List_map(list, bump_value, NULL);
+    }
+
+    return sum;
+}
+
+static void run(List * list, int n, const char *layout, char *junk)
+{
+    char name[64];
+    int reps = 3;
+    int kind = 0;
+    int rep = 0;
+
+    for (kind = 0; kind < NUM_WALKS; kind++) {
+        double best = 0;
+        long sum = 0;
+
+        for (rep = 0; rep < reps; rep++) {
+            evict(junk);
+            double start = bench_now();
+            sum = walk(list, kind);
+            double secs = bench_now() - start;
+            best = rep == 0 || secs < best ? secs : best;
+        }
+
+        snprintf(name, sizeof(name), "%s %s", layout, walk_names[kind]);
+        bench_report(name, n, best);
+        if (kind < MACRO_MAP && sum != (long)n * (n - 1) / 2) {
+            printf("wrong sum %ld\n", sum);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 10000000;
+    char *junk = calloc(EVICT_SIZE, 1);
+    List *list = NULL;
+
+    check_mem(junk);
+
+    // nodes in the order they were pushed, the usual case
+    list = scattered_list(n, 0);
+    run(list, n, "pushed", junk);
+    List_clear_destroy(list);
+
+    list = scattered_list(n, 1);
+    run(list, n, "shuffled", junk);
+    List_clear_destroy(list);
+
+error:          // fallthrough
+    free(junk);
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t u64_key(const void *value)
+{
+    return *(const uint64_t *)value;
+}
+
+static const char *str_key(const void *value)
+{
+    return value;
+}
+
+static List *id_list(uint64_t * ids, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        ids[i] = ((uint64_t)bench_rand(&seed) << 32) | bench_rand(&seed);
+        List_push(list, &ids[i]);
+    }
+
+    return list;
+}
+
+// fixed prefix keys like the ones we get from our log shards
+static List *str_list(char *strings, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        snprintf(&strings[i * 24], 24, "shard-07/%010u", bench_rand(&seed));
+        List_push(list, &strings[i * 24]);
+    }
+
+    return list;
+}
+
+static void run(int n)
+{
+    uint64_t *ids = malloc(n * sizeof(uint64_t));
+    char *strings = malloc(n * 24);
+    check_mem(ids);
+    check_mem(strings);
+
+    List *list = id_list(ids, n);
+    double start = bench_now();
+    List_merge_sort(list, cmp_u64);
+    bench_report("u64 List_merge_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = id_list(ids, n);
+    start = bench_now();
+    List_radix_sort(list, u64_key);
+    bench_report("u64 List_radix_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = str_list(strings, n);
+    start = bench_now();
+    List_merge_sort(list, (List_compare) strcmp);
+    bench_report("str List_merge_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = str_list(strings, n);
+    start = bench_now();
+    List_radix_sort_str(list, str_key);
+    bench_report("str List_radix_sort_str", n, bench_now() - start);
+    List_destroy(list);
+
+error:          // fallthrough
+    free(ids);
+    free(strings);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 10000000;
+    int n = 0;
+
+    for (n = 1000000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
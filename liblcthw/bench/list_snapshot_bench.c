@@ -0,0 +1,122 @@
+#include "bench.h"
+#include <lcthw/list_snapshot.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LINE_SIZE 128
+
+static const void *str_bytes(const void *value, size_t *size)
+{
+    *size = strlen(value) + 1;
+    return value;
+}
+
+// what a restart does now: one line per value, parsed back into strdups
+static List *load_text(const char *path)
+{
+    char line[LINE_SIZE];
+    List *list = List_create();
+    FILE *in = fopen(path, "r");
+    check(in != NULL, "Failed to open %s.", path);
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+        List_push(list, strdup(line));
+    }
+
+    fclose(in);
+    return list;
+
+error:
+    return list;
+}
+
+static size_t touch_all(List * list)
+{
+    size_t total = 0;
+
+    LIST_FOREACH(list, first, next, cur) {
+        total += strlen(cur->value);
+    }
+
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 5000000;
+    unsigned int seed = 42;
+    char text_path[64];
+    char snap_path[64];
+    List *list = List_create();
+    size_t total = 0;
+    int i = 0;
+
+    snprintf(text_path, sizeof(text_path), "/tmp/lcthw_bench_%d.txt",
+            (int)getpid());
+    snprintf(snap_path, sizeof(snap_path), "/tmp/lcthw_bench_%d.snap",
+            (int)getpid());
+
+    FILE *out = fopen(text_path, "w");
+    check(out != NULL, "Failed to open %s.", text_path);
+
+    for (i = 0; i < n; i++) {
+        char line[LINE_SIZE];
+        unsigned int r = bench_rand(&seed);
+        snprintf(line, sizeof(line), "user-%08u,%u,session-%06u,/api/v%u/items",
+                r, r % 997, (r >> 8) % 1000000, r % 3 + 1);
+        fprintf(out, "%s\n", line);
+        List_push(list, strdup(line));
+    }
+    fclose(out);
+
+    double start = bench_now();
+    check(List_save(list, snap_path, str_bytes) == 0, "Save failed.");
+    bench_report("List_save (with fsync)", n, bench_now() - start);
+
+    start = bench_now();
+    List *text = load_text(text_path);
+    bench_report("text: fgets + strdup", n, bench_now() - start);
+    start = bench_now();
+    size_t expect = touch_all(text);
+    bench_report("text: walk loaded list", n, bench_now() - start);
+
+    start = bench_now();
+    ListSnapshot *snap = List_load_mmap(snap_path);
+    check(snap != NULL, "Load failed.");
+    bench_report("List_load_mmap", n, bench_now() - start);
+
+    // straight off the map, no list at all
+    start = bench_now();
+    total = 0;
+    LIST_SNAPSHOT_FOREACH(snap, rec) {
+        total += strlen((const char *)rec->data);
+    }
+    bench_report("mmap: LIST_SNAPSHOT_FOREACH", n, bench_now() - start);
+    check(total == expect, "Snapshot doesn't match the text.");
+
+    start = bench_now();
+    List *mapped = ListSnapshot_to_list(snap);
+    bench_report("ListSnapshot_to_list", n, bench_now() - start);
+    start = bench_now();
+    total = touch_all(mapped);
+    bench_report("mmap: walk loaded list", n, bench_now() - start);
+    check(total == expect, "Snapshot doesn't match the text.");
+
+    start = bench_now();
+    check(ListSnapshot_verify(snap) == 0, "Verify failed.");
+    bench_report("ListSnapshot_verify", n, bench_now() - start);
+
+    List_destroy(mapped);
+    ListSnapshot_close(snap);
+    List_clear_destroy(text);
+
+error:          // fallthrough
+    List_clear_destroy(list);
+    remove(text_path);
+    remove(snap_path);
+    return 0;
+}
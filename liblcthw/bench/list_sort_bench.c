@@ -0,0 +1,87 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/list_sort.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+LIST_DEFINE_SORT(List_sort_int, int *, LIST_CMP_INT)
+LIST_DEFINE_SORT(List_sort_str, char *, LIST_CMP_STR)
+
+static List *int_list(int *values, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        values[i] = bench_rand(&seed);
+        List_push(list, &values[i]);
+    }
+
+    return list;
+}
+
+static List *str_list(char *strings, int n)
+{
+    unsigned int seed = 42;
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        snprintf(&strings[i * 16], 16, "%08x-key", bench_rand(&seed));
+        List_push(list, &strings[i * 16]);
+    }
+
+    return list;
+}
+
+static void run(int n)
+{
+    int *values = malloc(n * sizeof(int));
+    char *strings = malloc(n * 16);
+    check_mem(values);
+    check_mem(strings);
+
+    List *list = int_list(values, n);
+    double start = bench_now();
+    List_merge_sort(list, bench_cmp_int);
+    bench_report("int List_merge_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = int_list(values, n);
+    start = bench_now();
+    List_sort_int(list);
+    bench_report("int LIST_DEFINE_SORT", n, bench_now() - start);
+    List_destroy(list);
+
+    list = str_list(strings, n);
+    start = bench_now();
+    List_merge_sort(list, (List_compare) strcmp);
+    bench_report("str List_merge_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = str_list(strings, n);
+    start = bench_now();
+    List_sort_str(list);
+    bench_report("str LIST_DEFINE_SORT", n, bench_now() - start);
+    List_destroy(list);
+
+error:          // fallthrough
+    free(values);
+    free(strings);
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 0;
+
+    if (n > 0) {
+        run(n);
+    } else {
+        // cache resident, where the comparison dominates, then not
+        run(100000);
+        run(1000000);
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "bench.h"
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define BATCH 10000
+#define STAGES 4
+
+static void build(const char *name, List * list, void **values, int n,
+        int many)
+{
+    int i = 0;
+    double start = bench_now();
+
+    if (many) {
+        for (i = 0; i < n; i += BATCH) {
+            List_push_many(list, &values[i], n - i < BATCH ? n - i : BATCH);
+        }
+    } else {
+        for (i = 0; i < n; i++) {
+            List_push(list, values[i]);
+        }
+    }
+
+    bench_report(name, n, bench_now() - start);
+}
+
+/*
+ * Every item goes through STAGES lists, BATCH at a time, the way a
+ * pipeline hands work on: moved value by value, or split off and joined.
+ */
+static void pipeline(const char *name, List * source, int splice)
+{
+    List *stages[STAGES];
+    int n = List_count(source);
+    int i = 0;
+    int j = 0;
+
+    stages[0] = source;
+    for (i = 1; i < STAGES; i++) {
+        stages[i] = List_create_sharing(source);
+    }
+
+    double start = bench_now();
+
+    for (i = 0; i < STAGES - 1; i++) {
+        while (List_count(stages[i]) > 0) {
+            int count = List_count(stages[i]) < BATCH ?
+                List_count(stages[i]) : BATCH;
+
+            if (splice) {
+                ListNode *node = stages[i]->first;
+                for (j = 1; j < count; j++) {
+                    node = node->next;
+                }
+
+                // the batch is everything up to node, the rest stays behind
+                List *rest = List_split_at(stages[i], node->next,
+                        List_count(stages[i]) - count);
+                List_join(stages[i + 1], stages[i]);
+                List_join(stages[i], rest);
+                List_destroy(rest);
+            } else {
+                for (j = 0; j < count; j++) {
+                    List_push(stages[i + 1], List_shift(stages[i]));
+                }
+            }
+        }
+    }
+
+    bench_report(name, n * (STAGES - 1), bench_now() - start);
+
+    for (i = 1; i < STAGES; i++) {
+        List_destroy(stages[i]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    void **values = malloc(n * sizeof(void *));
+    int i = 0;
+
+    check_mem(values);
+    for (i = 0; i < n; i++) {
+        values[i] = (void *)(uintptr_t)i;
+    }
+
+    // every list lives to the end so no run gets another's freed memory
+    List *push = List_create();
+    List *many = List_create();
+    List *pooled_push = List_create_pooled(65536);
+    List *pooled_many = List_create_pooled(65536);
+
+    build("List_push", push, values, n, 0);
+    build("List_push_many 10k", many, values, n, 1);
+    build("pooled List_push", pooled_push, values, n, 0);
+    build("pooled List_push_many 10k", pooled_many, values, n, 1);
+
+    pipeline("stage handoff shift+push", push, 0);
+    pipeline("stage handoff split_at+join", many, 1);
+    pipeline("pooled stage handoff shift+push", pooled_push, 0);
+    pipeline("pooled stage handoff split_at+join", pooled_many, 1);
+
+    List_destroy(push);
+    List_destroy(many);
+    List_destroy(pooled_push);
+    List_destroy(pooled_many);
+
+error:          // fallthrough
+    free(values);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+enum { SORTED, REVERSED, FEW_SWAPS, RANDOM, NUM_INPUTS };
+
+static const char *input_names[] = { "sorted", "reversed", "few-swaps",
+    "random" };
+
+static long compares = 0;
+
+static int counting_cmp(const void *a, const void *b)
+{
+    compares++;
+    return bench_cmp_int(a, b);
+}
+
+static void fill_values(int *values, int n, int input)
+{
+    unsigned int seed = 42;
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        values[i] = input == REVERSED ? n - i :
+            input == RANDOM ? (int)bench_rand(&seed) : i;
+    }
+
+    if (input == FEW_SWAPS) {
+        // 1% of the elements end up out of place
+        for (i = 0; i < n / 100; i++) {
+            int a = bench_rand(&seed) % n;
+            int b = bench_rand(&seed) % n;
+            int tmp = values[a];
+            values[a] = values[b];
+            values[b] = tmp;
+        }
+    }
+}
+
+static void run(const char *sort, int *values, int n, int input)
+{
+    char name[64];
+    int i = 0;
+    List *list = List_create_pooled(65536);
+
+    for (i = 0; i < n; i++) {
+        List_push(list, &values[i]);
+    }
+
+    compares = 0;
+    double start = bench_now();
+
+    if (sort[0] == 't') {
+        List_tim_sort(list, counting_cmp);
+    } else if (sort[0] == 'm') {
+        List_merge_sort(list, counting_cmp);
+    } else {
+        List_bubble_sort(list, counting_cmp);
+    }
+
+    double elapsed = bench_now() - start;
+    snprintf(name, sizeof(name), "%s %s", sort, input_names[input]);
+    bench_report(name, n, elapsed);
+    printf("%-36s compares/n=%.2f\n", name, (double)compares / n);
+
+    List_destroy(list);
+}
+
+int main(int argc, char *argv[])
+{
+    int sizes[] = { 10000, 1000000 };
+    int max = argc > 1 ? atoi(argv[1]) : 1000000;
+    int i = 0;
+    int input = 0;
+
+    for (i = 0; i < 2 && sizes[i] <= max; i++) {
+        int n = sizes[i];
+        int *values = malloc(n * sizeof(int));
+        check_mem(values);
+
+        for (input = 0; input < NUM_INPUTS; input++) {
+            fill_values(values, n, input);
+            run("tim_sort", values, n, input);
+            run("merge_sort", values, n, input);
+            // quadratic, so only on the small size
+            if (n <= 10000) run("bubble_sort", values, n, input);
+        }
+
+        free(values);
+    }
+
+    return 0;
+
+error:
+    return 1;
+}
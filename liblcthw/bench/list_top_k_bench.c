@@ -0,0 +1,66 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/darray.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+static List *random_list(int *values, int n)
+{
+    List *list = List_create();
+    int i = 0;
+
+    bench_fill(values, n, BENCH_RANDOM);
+    for (i = 0; i < n; i++) {
+        List_push(list, &values[i]);
+    }
+
+    return list;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 4000000;
+    int ks[] = { 1, 10, 100, 1000, 10000, 100000 };
+    char name[64];
+    int i = 0;
+
+    int *values = malloc(n * sizeof(int));
+    check_mem(values);
+
+    List *list = random_list(values, n);
+    double start = bench_now();
+    List_merge_sort(list, bench_cmp_int);
+    bench_report("List_merge_sort", n, bench_now() - start);
+    List_destroy(list);
+
+    list = random_list(values, n);
+    for (i = 0; i < (int)(sizeof(ks) / sizeof(ks[0])); i++) {
+        start = bench_now();
+        DArray *top = List_top_k(list, ks[i], bench_cmp_int);
+        snprintf(name, sizeof(name), "List_top_k k=%d", ks[i]);
+        bench_report(name, n, bench_now() - start);
+        DArray_destroy(top);
+    }
+    List_destroy(list);
+
+    for (i = 0; i < (int)(sizeof(ks) / sizeof(ks[0])); i++) {
+        list = random_list(values, n);
+        start = bench_now();
+        List_nth_element(list, n - ks[i], bench_cmp_int);
+        snprintf(name, sizeof(name), "List_nth_element n-%d", ks[i]);
+        bench_report(name, n, bench_now() - start);
+        List_destroy(list);
+    }
+
+    list = random_list(values, n);
+    start = bench_now();
+    List_nth_element(list, n / 2, bench_cmp_int);
+    bench_report("List_nth_element median", n, bench_now() - start);
+    List_destroy(list);
+
+    free(values);
+    return 0;
+
+error:
+    return 1;
+}
@@ -0,0 +1,168 @@
+#include "bench.h"
+#include <lcthw/plist.h>
+#include <lcthw/list.h>
+#include <lcthw/dbg.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define WINDOW 10000
+#define MAX_READERS 8
+
+enum { LOCKED_COPY, PLIST, NUM_KINDS };
+
+static const char *const kind_names[] = { "List + mutex, copy per read",
+    "PList snapshot per read" };
+
+typedef struct Shared {
+    int kind;
+    List *list;
+    pthread_mutex_t lock;
+    PList *plist;
+    atomic_int stop;
+    atomic_long writes;
+    atomic_long reads;
+    atomic_long checksum;
+} Shared;
+
+// a sliding window: push the next number, shift the oldest
+static void *writer(void *arg)
+{
+    Shared *shared = arg;
+    intptr_t i = WINDOW;
+    long writes = 0;
+
+    while (!atomic_load_explicit(&shared->stop, memory_order_relaxed)) {
+        i++;
+
+        if (shared->kind == LOCKED_COPY) {
+            pthread_mutex_lock(&shared->lock);
+            List_push(shared->list, (void *)i);
+            List_shift(shared->list);
+            pthread_mutex_unlock(&shared->lock);
+        } else {
+            PList_push(shared->plist, (void *)i);
+            PList_shift(shared->plist);
+        }
+
+        writes++;
+    }
+
+    atomic_fetch_add(&shared->writes, writes);
+    return NULL;
+}
+
+// what a report does today: copy everything out under the lock, then sum
+static long read_locked(Shared * shared, intptr_t *copy)
+{
+    long sum = 0;
+    int n = 0;
+    int i = 0;
+
+    pthread_mutex_lock(&shared->lock);
+    LIST_FOREACH(shared->list, first, next, cur) {
+        copy[n++] = (intptr_t)cur->value;
+    }
+    pthread_mutex_unlock(&shared->lock);
+
+    for (i = 0; i < n; i++) {
+        sum += copy[i];
+    }
+
+    return sum;
+}
+
+static long read_plist(Shared * shared)
+{
+    PListSnapshot snap = PList_snapshot(shared->plist);
+    long sum = 0;
+
+    PLIST_FOREACH(snap, cur) {
+        sum += (intptr_t)cur->value;
+    }
+
+    PList_release(&snap);
+    return sum;
+}
+
+static void *reader(void *arg)
+{
+    Shared *shared = arg;
+    intptr_t *copy = malloc(WINDOW * sizeof(intptr_t));
+    long reads = 0;
+    long checksum = 0;
+
+    check_mem(copy);
+
+    while (!atomic_load_explicit(&shared->stop, memory_order_relaxed)) {
+        checksum += shared->kind == LOCKED_COPY ?
+            read_locked(shared, copy) : read_plist(shared);
+        reads++;
+    }
+
+    atomic_fetch_add(&shared->reads, reads);
+    atomic_fetch_add(&shared->checksum, checksum);
+
+error:          // fallthrough
+    free(copy);
+    return NULL;
+}
+
+static void run(int kind, int nreaders, double secs)
+{
+    pthread_t readers[MAX_READERS];
+    pthread_t write_thread;
+    Shared shared = { .kind = kind };
+    intptr_t i = 0;
+
+    shared.list = List_create();
+    shared.plist = PList_create();
+    pthread_mutex_init(&shared.lock, NULL);
+
+    for (i = 1; i <= WINDOW; i++) {
+        List_push(shared.list, (void *)i);
+        PList_push(shared.plist, (void *)i);
+    }
+
+    for (i = 0; i < nreaders; i++) {
+        pthread_create(&readers[i], NULL, reader, &shared);
+    }
+    pthread_create(&write_thread, NULL, writer, &shared);
+
+    usleep((useconds_t)(secs * 1e6));
+    atomic_store(&shared.stop, 1);
+
+    pthread_join(write_thread, NULL);
+    for (i = 0; i < nreaders; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    printf("%-28s %d readers %10.0f writes/s %8.0f reads/s %6.2f Gitems/s read\n",
+            kind_names[kind], nreaders, atomic_load(&shared.writes) / secs,
+            atomic_load(&shared.reads) / secs,
+            atomic_load(&shared.reads) * (double)WINDOW / secs / 1e9);
+
+    List_destroy(shared.list);
+    PList_destroy(shared.plist);
+    pthread_mutex_destroy(&shared.lock);
+}
+
+int main(int argc, char *argv[])
+{
+    double secs = argc > 1 ? atof(argv[1]) : 1.0;
+    int nreaders = 0;
+    int kind = 0;
+
+    printf("%ld cores online, %d item window\n",
+            sysconf(_SC_NPROCESSORS_ONLN), WINDOW);
+
+    for (nreaders = 1; nreaders <= MAX_READERS; nreaders *= 2) {
+        for (kind = 0; kind < NUM_KINDS; kind++) {
+            run(kind, nreaders, secs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "bench.h"
+#include <lcthw/pqueue.h>
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+/*
+ * The scheduler loop: n timers are pending, each step takes the one
+ * due first and re-arms it a random interval later.
+ */
+
+#define OPS 200000
+
+// what the schedulers did before, walk to the spot and link a node in
+static void list_insert_sorted(List * list, void *value, List_compare cmp)
+{
+    ListNode *cur = list->first;
+
+    while (cur != NULL && cmp(cur->value, value) <= 0) {
+        cur = cur->next;
+    }
+
+    if (cur == NULL) {
+        List_push(list, value);
+    } else if (cur == list->first) {
+        List_unshift(list, value);
+    } else {
+        ListNode *node = calloc(1, sizeof(ListNode));
+        node->value = value;
+        node->next = cur;
+        node->prev = cur->prev;
+        cur->prev->next = node;
+        cur->prev = node;
+        list->count++;
+    }
+}
+
+static void run(int n)
+{
+    char name[64];
+    unsigned int seed = 42;
+    // a sorted insert walks half the list, so give it fewer steps
+    int list_ops = OPS / (n / 1000);
+    int bubble_ops = n <= 1000 ? 500 : 0;
+    int i = 0;
+
+    int *deadlines = malloc(n * sizeof(int));
+    check_mem(deadlines);
+
+    for (i = 0; i < n; i++) {
+        deadlines[i] = bench_rand(&seed) % (n * 4);
+    }
+
+    List *list = List_create();
+    for (i = 0; i < n; i++) {
+        List_push(list, &deadlines[i]);
+    }
+
+    double start = bench_now();
+    PQueue *queue = PQueue_from_list(list, bench_cmp_int);
+    snprintf(name, sizeof(name), "PQueue_from_list n=%d", n);
+    bench_report(name, n, bench_now() - start);
+    PQueue_destroy(queue);
+
+    start = bench_now();
+    queue = PQueue_create(bench_cmp_int);
+    for (i = 0; i < n; i++) {
+        PQueue_push(queue, &deadlines[i]);
+    }
+    snprintf(name, sizeof(name), "PQueue_push n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < OPS; i++) {
+        int *due = PQueue_pop(queue);
+        *due += 1 + bench_rand(&seed) % n;
+        PQueue_push(queue, due);
+    }
+    snprintf(name, sizeof(name), "PQueue pop+push n=%d", n);
+    bench_report(name, OPS, bench_now() - start);
+
+    List_merge_sort(list, bench_cmp_int);
+
+    start = bench_now();
+    for (i = 0; i < list_ops; i++) {
+        int *due = List_shift(list);
+        *due += 1 + bench_rand(&seed) % n;
+        list_insert_sorted(list, due, bench_cmp_int);
+    }
+    snprintf(name, sizeof(name), "List shift+sorted insert n=%d", n);
+    bench_report(name, list_ops, bench_now() - start);
+
+    if (bubble_ops > 0) {
+        start = bench_now();
+        for (i = 0; i < bubble_ops; i++) {
+            int *due = List_shift(list);
+            *due += 1 + bench_rand(&seed) % n;
+            List_push(list, due);
+            List_bubble_sort(list, bench_cmp_int);
+        }
+        snprintf(name, sizeof(name), "List shift+push+bubble n=%d", n);
+        bench_report(name, bubble_ops, bench_now() - start);
+    }
+
+    PQueue_destroy(queue);
+    List_destroy(list);
+
+error:          // fallthrough
+    free(deadlines);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 100000;
+    int n = 0;
+
+    for (n = 1000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
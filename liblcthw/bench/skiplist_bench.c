@@ -0,0 +1,86 @@
+#include "bench.h"
+#include <lcthw/skiplist.h>
+#include <lcthw/list_algos.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+#define SEEKS 100000
+#define RANGE 100
+#define RESORTS 10
+
+static void run(int n)
+{
+    char name[64];
+    unsigned int seed = 7;
+    long sum = 0;
+    int i = 0;
+
+    int *values = malloc(n * sizeof(int));
+    check_mem(values);
+    bench_fill(values, n, BENCH_RANDOM);
+
+    double start = bench_now();
+    List *list = List_create();
+    for (i = 0; i < n; i++) {
+        List_push(list, &values[i]);
+    }
+    List_merge_sort(list, bench_cmp_int);
+    snprintf(name, sizeof(name), "List push+merge_sort n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    SkipList *skip = SkipList_create(bench_cmp_int);
+    for (i = 0; i < n; i++) {
+        SkipList_insert(skip, &values[i]);
+    }
+    snprintf(name, sizeof(name), "SkipList_insert n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    // keeping it sorted while it grows: one more value, then read it in order
+    start = bench_now();
+    for (i = 0; i < RESORTS; i++) {
+        List_push(list, &values[bench_rand(&seed) % n]);
+        List_merge_sort(list, bench_cmp_int);
+    }
+    snprintf(name, sizeof(name), "List push+resort n=%d", n);
+    bench_report(name, RESORTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < RESORTS; i++) {
+        SkipList_insert(skip, &values[bench_rand(&seed) % n]);
+    }
+    snprintf(name, sizeof(name), "SkipList_insert into n=%d", n);
+    bench_report(name, RESORTS, bench_now() - start);
+
+    start = bench_now();
+    for (i = 0; i < SEEKS; i++) {
+        int r = 0;
+        SKIPLIST_FOREACH_FROM(SkipList_lower_bound(skip,
+                    &values[bench_rand(&seed) % n]), next, cur) {
+            if (r++ == RANGE) break;
+            sum += *(int *)cur->value;
+        }
+    }
+    snprintf(name, sizeof(name), "SkipList seek+scan %d n=%d", RANGE, n);
+    bench_report(name, SEEKS, bench_now() - start);
+
+    printf("%-36s checksum %ld\n", "", sum);
+
+    SkipList_destroy(skip);
+    List_destroy(list);
+
+error:          // fallthrough
+    free(values);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 1000000;
+    int n = 0;
+
+    for (n = 10000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/threadpool.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// rounds of xorshift per value, enough that the callback is the cost
+#define WORK 200
+
+enum { EVEN, SKEWED, NUM_LOADS };
+
+static const char *const load_names[] = { "even", "skewed" };
+
+static inline uintptr_t burn(uintptr_t x, int rounds)
+{
+    unsigned int state = (unsigned int)x | 1;
+    int i = 0;
+
+    for (i = 0; i < rounds; i++) {
+        bench_rand(&state);
+    }
+
+    return state;
+}
+
+// the low eighth of the values cost 16 times as much as the rest
+static inline int rounds_for(uintptr_t value, void *ctx)
+{
+    uintptr_t n = (uintptr_t)ctx;
+    return n != 0 && value < n / 8 ? WORK * 16 : WORK;
+}
+
+static void *map_burn(void *value, void *ctx)
+{
+    uintptr_t x = (uintptr_t)value;
+    // xorshift never gets to 0, but the compiler can't drop the work
+    return burn(x, rounds_for(x, ctx)) == 0 ? NULL : value;
+}
+
+static void *reduce_burn(void *acc, void *value, void *ctx)
+{
+    uintptr_t x = (uintptr_t)value;
+    return (void *)((uintptr_t)acc ^ burn(x, rounds_for(x, ctx)));
+}
+
+static void *combine_xor(void *acc, void *other, void *ctx)
+{
+    (void)ctx;
+    return (void *)((uintptr_t)acc ^ (uintptr_t)other);
+}
+
+static void run(List * list, int n, int load)
+{
+    void *ctx = (void *)(uintptr_t)(load == SKEWED ? n : 0);
+    char name[64];
+    uintptr_t expect = 0;
+    double serial = 0;
+    int threads = 0;
+
+    double start = bench_now();
+    LIST_FOREACH(list, first, next, cur) {
+        expect ^= (uintptr_t)reduce_burn(NULL, cur->value, ctx);
+    }
+    serial = bench_now() - start;
+    snprintf(name, sizeof(name), "%s serial fold", load_names[load]);
+    bench_report(name, n, serial);
+
+    for (threads = 1; threads <= 8; threads *= 2) {
+        ThreadPool *pool = ThreadPool_create(threads);
+        check(pool != NULL, "Failed to create pool.");
+
+        start = bench_now();
+        List_parallel_map(pool, list, map_burn, ctx);
+        double secs = bench_now() - start;
+        snprintf(name, sizeof(name), "%s map %d threads", load_names[load],
+                threads);
+        bench_report(name, n, secs);
+        printf("%-36s %.2fx serial\n", "", serial / secs);
+
+        start = bench_now();
+        void *result = List_parallel_reduce(pool, list, NULL, reduce_burn,
+                combine_xor, ctx);
+        secs = bench_now() - start;
+        snprintf(name, sizeof(name), "%s reduce %d threads", load_names[load],
+                threads);
+        bench_report(name, n, secs);
+        printf("%-36s %.2fx serial\n", "", serial / secs);
+
+        check((uintptr_t)result == expect, "Parallel reduce disagrees.");
+        ThreadPool_destroy(pool);
+    }
+
+error:          // fallthrough
+    return;
+}
+
+int main(int argc, char *argv[])
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    List *list = List_create_pooled(65536);
+    int load = 0;
+    int i = 0;
+
+    printf("%ld cores online\n", sysconf(_SC_NPROCESSORS_ONLN));
+
+    for (i = 0; i < n; i++) {
+        List_push(list, (void *)(uintptr_t)i);
+    }
+
+    for (load = EVEN; load < NUM_LOADS; load++) {
+        run(list, n, load);
+    }
+
+    List_destroy(list);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "bench.h"
+#include <lcthw/typed_list.h>
+#include <lcthw/list_sort.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+DEFINE_TYPED_LIST(IntList, int)
+DEFINE_TYPED_LIST_SORT(IntList, IntList_sort, LIST_CMP_INT)
+LIST_DEFINE_SORT(List_sort_int, int *, LIST_CMP_INT)
+
+static void run(int n)
+{
+    char name[64];
+    unsigned int seed = 42;
+    long sum = 0;
+    int i = 0;
+
+    // what the pipelines do today: a malloc for every int, then a List node
+    double start = bench_now();
+    List *list = List_create();
+    for (i = 0; i < n; i++) {
+        int *value = malloc(sizeof(int));
+        *value = bench_rand(&seed);
+        List_push(list, value);
+    }
+    snprintf(name, sizeof(name), "List of int * push n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    List_sort_int(list);
+    snprintf(name, sizeof(name), "List_sort_int n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    LIST_FOREACH(list, first, next, cur) {
+        sum += *(int *)cur->value;
+    }
+    snprintf(name, sizeof(name), "List of int * scan n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    seed = 42;
+    start = bench_now();
+    IntList *ints = IntList_create();
+    for (i = 0; i < n; i++) {
+        IntList_push(ints, bench_rand(&seed));
+    }
+    snprintf(name, sizeof(name), "IntList push n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    IntList_sort(ints);
+    snprintf(name, sizeof(name), "IntList_sort n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    start = bench_now();
+    TYPED_LIST_FOREACH(IntList, ints, first, next, node) {
+        sum -= node->value;
+    }
+    snprintf(name, sizeof(name), "IntList scan n=%d", n);
+    bench_report(name, n, bench_now() - start);
+
+    // freed only now, or IntList would get the List's scattered free chunks
+    List_clear_destroy(list);
+    IntList_destroy(ints);
+
+    // both lists held the same values, so this comes out to zero
+    printf("%-36s checksum %ld\n", "", sum);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 1000000;
+    int n = 0;
+
+    for (n = 10000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "bench.h"
+#include <lcthw/list_algos.h>
+#include <lcthw/ulist.h>
+#include <lcthw/dbg.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define SCANS 5
+
+static int *values = NULL;
+
+// only touches the container, not the values, so it measures traversal
+static uintptr_t scan_list(List * list)
+{
+    uintptr_t sum = 0;
+
+    LIST_FOREACH(list, first, next, cur) {
+        sum += (uintptr_t)cur->value;
+    }
+
+    return sum;
+}
+
+static uintptr_t scan_ulist(UList * list)
+{
+    uintptr_t sum = 0;
+
+    ULIST_FOREACH(list, chunk, i) {
+        sum += (uintptr_t)chunk->values[i];
+    }
+
+    return sum;
+}
+
+static void run(int n)
+{
+    unsigned int seed = 42;
+    uintptr_t check = 0;
+    int i = 0;
+    int s = 0;
+
+    values = malloc(n * sizeof(int));
+    check_mem(values);
+
+    for (i = 0; i < n; i++) {
+        values[i] = bench_rand(&seed);
+    }
+
+    List *list = List_create();
+    UList *ulist = UList_create();
+
+    for (i = 0; i < n; i++) {
+        List_push(list, &values[i]);
+        UList_push(ulist, &values[i]);
+    }
+
+    double start = bench_now();
+    for (s = 0; s < SCANS; s++) check += scan_list(list);
+    bench_report("scan List in push order", n * SCANS, bench_now() - start);
+
+    start = bench_now();
+    for (s = 0; s < SCANS; s++) check -= scan_ulist(ulist);
+    bench_report("scan UList in push order", n * SCANS, bench_now() - start);
+
+    // sorting scatters the List nodes across the heap, UList stays packed
+    List_merge_sort(list, bench_cmp_int);
+    UList_merge_sort(ulist, bench_cmp_int);
+
+    start = bench_now();
+    for (s = 0; s < SCANS; s++) check += scan_list(list);
+    bench_report("scan List after sort", n * SCANS, bench_now() - start);
+
+    start = bench_now();
+    for (s = 0; s < SCANS; s++) check -= scan_ulist(ulist);
+    bench_report("scan UList after sort", n * SCANS, bench_now() - start);
+
+    printf("%-36s List %zu B, UList %.1f B (checksum %lu)\n",
+            "bytes per element", sizeof(ListNode),
+            (double)sizeof(UListChunk) / ULIST_CHUNK, (unsigned long)check);
+
+    List_destroy(list);
+    UList_destroy(ulist);
+
+error:          // fallthrough
+    free(values);
+}
+
+int main(int argc, char *argv[])
+{
+    int max = argc > 1 ? atoi(argv[1]) : 10000000;
+    int n = 0;
+
+    for (n = 1000000; n <= max; n *= 10) {
+        run(n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <lcthw/clist.h>
+#include <lcthw/dbg.h>
+
+#define CLIST_MIN_CAPACITY 16
+
+CList *CList_create()
+{
+    CList *list = calloc(1, sizeof(CList));
+    check_mem(list);
+
+    list->first = list->last = list->free = CLIST_NIL;
+
+    return list;
+
+error:
+    return NULL;
+}
+
+void CList_destroy(CList * list)
+{
+    if (list) {
+        free(list->nodes);
+        free(list);
+    }
+}
+
+void CList_clear(CList * list)
+{
+    CLIST_FOREACH(list, first, next, cur) {
+        free(cur->value);
+    }
+}
+
+CList *CList_copy(CList * list)
+{
+    CList *copy = CList_create();
+    check(copy != NULL, "Failed to create the copy.");
+
+    *copy = *list;
+    copy->nodes = NULL;
+
+    if (list->used > 0) {
+        // only the slots in use, the copy starts out with no slack
+        copy->capacity = list->used;
+        copy->nodes = malloc(list->used * sizeof(CListNode));
+        check_mem(copy->nodes);
+        memcpy(copy->nodes, list->nodes, list->used * sizeof(CListNode));
+    }
+
+    return copy;
+
+error:
+    CList_destroy(copy);
+    return NULL;
+}
+
+static uint32_t CList_alloc(CList * list, void *value)
+{
+    uint32_t index = list->free;
+
+    if (index != CLIST_NIL) {
+        list->free = list->nodes[index].next;
+    } else {
+        if (list->used == list->capacity) {
+            uint32_t capacity = list->capacity < CLIST_MIN_CAPACITY ?
+                CLIST_MIN_CAPACITY : list->capacity * 2;
+
+            // CLIST_NIL is never a real index
+            if (capacity <= list->capacity || capacity == CLIST_NIL) {
+                capacity = CLIST_NIL - 1;
+            }
+            check(capacity > list->capacity, "CList is full.");
+
+            CListNode *nodes = realloc(list->nodes, (size_t)capacity *
+                    sizeof(CListNode));
+            check_mem(nodes);
+
+            list->nodes = nodes;
+            list->capacity = capacity;
+        }
+
+        index = list->used++;
+    }
+
+    list->nodes[index].value = value;
+    list->count++;
+    return index;
+
+error:
+    return CLIST_NIL;
+}
+
+uint32_t CList_push(CList * list, void *value)
+{
+    uint32_t index = CList_alloc(list, value);
+    check(index != CLIST_NIL, "Failed to push.");
+
+    CListNode *node = &list->nodes[index];
+    node->next = CLIST_NIL;
+    node->prev = list->last;
+
+    if (list->last == CLIST_NIL) {
+        list->first = index;
+    } else {
+        list->nodes[list->last].next = index;
+    }
+
+    list->last = index;
+
+error:          // fallthrough
+    return index;
+}
+
+void *CList_pop(CList * list)
+{
+    return list->last != CLIST_NIL ? CList_remove(list, list->last) : NULL;
+}
+
+uint32_t CList_unshift(CList * list, void *value)
+{
+    uint32_t index = CList_alloc(list, value);
+    check(index != CLIST_NIL, "Failed to unshift.");
+
+    CListNode *node = &list->nodes[index];
+    node->prev = CLIST_NIL;
+    node->next = list->first;
+
+    if (list->first == CLIST_NIL) {
+        list->last = index;
+    } else {
+        list->nodes[list->first].prev = index;
+    }
+
+    list->first = index;
+
+error:          // fallthrough
+    return index;
+}
+
+void *CList_shift(CList * list)
+{
+    return list->first != CLIST_NIL ? CList_remove(list, list->first) : NULL;
+}
+
+void *CList_remove(CList * list, uint32_t index)
+{
+    void *result = NULL;
+
+    // a free slot points back at itself, a live node never does
+    check(index < list->used && list->nodes[index].prev != index,
+            "Invalid index %u.", index);
+
+    CListNode *node = &list->nodes[index];
+
+    if (node->prev == CLIST_NIL) {
+        list->first = node->next;
+    } else {
+        list->nodes[node->prev].next = node->next;
+    }
+
+    if (node->next == CLIST_NIL) {
+        list->last = node->prev;
+    } else {
+        list->nodes[node->next].prev = node->prev;
+    }
+
+    result = node->value;
+    node->value = NULL;
+    node->prev = index;
+    node->next = list->free;
+    list->free = index;
+    list->count--;
+
+error:          // fallthrough
+    return result;
+}
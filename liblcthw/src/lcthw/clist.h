@@ -0,0 +1,62 @@
+#ifndef lcthw_CList_h
+#define lcthw_CList_h
+
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * Compact list: the nodes live in one array and link to each other by
+ * uint32_t index, so a node is 16 bytes with no malloc header, and the
+ * whole list can be copied with one memcpy. Indices stay put while a
+ * value is on the list, but the array moves as it grows, so don't hold
+ * on to node pointers across a push or unshift. Removed slots go on a
+ * free stack threaded through next and are handed out first.
+ */
+
+#define CLIST_NIL UINT32_MAX
+
+typedef struct CListNode {
+    uint32_t next;
+    uint32_t prev;
+    void *value;
+} CListNode;
+
+typedef struct CList {
+    int count;
+    uint32_t first;
+    uint32_t last;
+    uint32_t free;
+    uint32_t used;
+    uint32_t capacity;
+    CListNode *nodes;
+} CList;
+
+CList *CList_create();
+void CList_destroy(CList * list);
+void CList_clear(CList * list);
+
+// one allocation and one memcpy, indices carry over to the copy
+CList *CList_copy(CList * list);
+
+#define CList_count(A) ((A)->count)
+#define CList_first(A) ((A)->first != CLIST_NIL ? (A)->nodes[(A)->first].value : NULL)
+#define CList_last(A) ((A)->last != CLIST_NIL ? (A)->nodes[(A)->last].value : NULL)
+
+// the node's index, CLIST_NIL if it couldn't grow
+uint32_t CList_push(CList * list, void *value);
+void *CList_pop(CList * list);
+
+uint32_t CList_unshift(CList * list, void *value);
+void *CList_shift(CList * list);
+
+void *CList_remove(CList * list, uint32_t index);
+
+#define CList_node(L, I) ((I) != CLIST_NIL ? &(L)->nodes[(I)] : NULL)
+#define CList_index(L, N) ((uint32_t)((N) - (L)->nodes))
+
+#define CLIST_FOREACH(L, S, M, V) CListNode *_cnode = NULL;\
+                                                    CListNode *V = NULL;\
+for(V = _cnode = CList_node(L, L->S); _cnode != NULL;\
+        V = _cnode = CList_node(L, _cnode->M))
+
+#endif
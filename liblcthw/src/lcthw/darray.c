@@ -0,0 +1,351 @@
+#include <lcthw/darray.h>
+#include <assert.h>
+
+#define DARRAY_INSERTION_CUTOFF 16
+
+static DArray *DArray_alloc(size_t element_size, size_t initial_max,
+        int inline_values)
+{
+    DArray *array = malloc(sizeof(DArray));
+    check_mem(array);
+    array->max = initial_max;
+    check(array->max > 0, "You must set an initial_max > 0.");
+
+    array->element_size = element_size;
+    array->inline_values = inline_values;
+    array->contents = calloc(initial_max, DArray_stride(array));
+    check_mem(array->contents);
+
+    array->end = 0;
+    array->expand_rate = DEFAULT_EXPAND_RATE;
+
+    return array;
+
+error:
+    if (array) free(array);
+    return NULL;
+}
+
+DArray *DArray_create(size_t element_size, size_t initial_max)
+{
+    return DArray_alloc(element_size, initial_max, 0);
+}
+
+DArray *DArray_create_inline(size_t element_size, size_t initial_max)
+{
+    check(element_size > 0, "Inline darrays need an element_size > 0.");
+    return DArray_alloc(element_size, initial_max, 1);
+
+error:
+    return NULL;
+}
+
+void DArray_clear(DArray * array)
+{
+    int i = 0;
+
+    if (array->element_size > 0 && !array->inline_values) {
+        for (i = 0; i < array->max; i++) {
+            void **contents = array->contents;
+            if (contents[i] != NULL) {
+                free(contents[i]);
+            }
+        }
+    }
+}
+
+static inline int DArray_resize(DArray * array, size_t newsize)
+{
+    check(newsize > 0, "The newsize must be > 0.");
+
+    void *contents = realloc(array->contents, newsize * DArray_stride(array));
+    // check contents and assume realloc doesn't harm the original on error
+    check_mem(contents);
+
+    // only now, a failed realloc leaves the old max and contents alone
+    array->contents = contents;
+    array->max = newsize;
+
+    return 0;
+error:
+    return -1;
+}
+
+/*
+ * Grows to at least min_max, and by at least half again the current
+ * size so a run of pushes costs amortized O(1).
+ */
+int DArray_expand(DArray * array, int min_max)
+{
+    size_t old_max = array->max;
+    size_t new_max = old_max + (old_max / 2 > array->expand_rate ?
+            old_max / 2 : array->expand_rate);
+
+    if (new_max < (size_t)min_max) {
+        new_max = min_max;
+    }
+
+    check(DArray_resize(array, new_max) == 0,
+            "Failed to expand array to new size: %d", (int)new_max);
+
+    memset(DArray_slot(array, old_max), 0,
+            (new_max - old_max) * DArray_stride(array));
+    return 0;
+
+error:
+    return -1;
+}
+
+int DArray_shrink_to_fit(DArray * array)
+{
+    int new_size = array->end > 0 ? array->end : 1;
+
+    return DArray_resize(array, new_size);
+}
+
+void DArray_destroy(DArray * array)
+{
+    if (array) {
+        if (array->contents)
+            free(array->contents);
+        free(array);
+    }
+}
+
+void DArray_clear_destroy(DArray * array)
+{
+    DArray_clear(array);
+    DArray_destroy(array);
+}
+
+int DArray_push(DArray * array, void *el)
+{
+    if (array->end >= array->max) {
+        check(DArray_expand(array, array->end + 1) == 0,
+                "Failed to expand the darray.");
+    }
+
+    DArray_set(array, array->end, el);
+    array->end++;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void *DArray_pop(DArray * array)
+{
+    check(array->end - 1 >= 0, "Attempt to pop from empty array.");
+
+    void *el = DArray_remove(array, array->end - 1);
+    array->end--;
+
+    return el;
+error:
+    return NULL;
+}
+
+// what cmp gets for slot i: the stored pointer, or the inline element
+#define DArray_key(A, I) ((A)->inline_values ? (void *)DArray_slot((A), (I)) :\
+        ((void **)(A)->contents)[(I)])
+
+static inline void DArray_swap(DArray * array, int a, int b, char *temp)
+{
+    if (array->inline_values) {
+        memcpy(temp, DArray_slot(array, a), array->element_size);
+        memcpy(DArray_slot(array, a), DArray_slot(array, b),
+                array->element_size);
+        memcpy(DArray_slot(array, b), temp, array->element_size);
+    } else {
+        void **contents = array->contents;
+        void *el = contents[a];
+        contents[a] = contents[b];
+        contents[b] = el;
+    }
+}
+
+static void DArray_sift_down(DArray * array, int start, int root, int end,
+        List_compare cmp, char *temp)
+{
+    // heap over [start, end), root counted from start
+    while (2 * root + 1 < end - start) {
+        int child = 2 * root + 1;
+
+        if (child + 1 < end - start &&
+                cmp(DArray_key(array, start + child),
+                    DArray_key(array, start + child + 1)) < 0) {
+            child++;
+        }
+
+        if (cmp(DArray_key(array, start + root),
+                    DArray_key(array, start + child)) >= 0) {
+            return;
+        }
+
+        DArray_swap(array, start + root, start + child, temp);
+        root = child;
+    }
+}
+
+static void DArray_heapsort_range(DArray * array, int start, int end,
+        List_compare cmp, char *temp)
+{
+    int n = end - start;
+    int i = 0;
+
+    for (i = n / 2 - 1; i >= 0; i--) {
+        DArray_sift_down(array, start, i, end, cmp, temp);
+    }
+
+    for (i = n - 1; i > 0; i--) {
+        DArray_swap(array, start, start + i, temp);
+        DArray_sift_down(array, start, 0, start + i, cmp, temp);
+    }
+}
+
+static void DArray_insertion_range(DArray * array, int start, int end,
+        List_compare cmp, char *temp)
+{
+    int i = 0;
+    int j = 0;
+
+    for (i = start + 1; i < end; i++) {
+        for (j = i; j > start && cmp(DArray_key(array, j - 1),
+                    DArray_key(array, j)) > 0; j--) {
+            DArray_swap(array, j - 1, j, temp);
+        }
+    }
+}
+
+/*
+ * Quicksort with a median of three pivot. Small ranges finish with
+ * insertion sort, and a range that recurses too deep is handed to
+ * heapsort so bad inputs can't make it quadratic.
+ */
+static void DArray_introsort(DArray * array, int start, int end, int depth,
+        List_compare cmp, char *temp)
+{
+    while (end - start > DARRAY_INSERTION_CUTOFF) {
+        if (depth-- == 0) {
+            DArray_heapsort_range(array, start, end, cmp, temp);
+            return;
+        }
+
+        int mid = start + (end - start) / 2;
+        int last = end - 1;
+
+        if (cmp(DArray_key(array, mid), DArray_key(array, start)) < 0)
+            DArray_swap(array, mid, start, temp);
+        if (cmp(DArray_key(array, last), DArray_key(array, start)) < 0)
+            DArray_swap(array, last, start, temp);
+        if (cmp(DArray_key(array, last), DArray_key(array, mid)) < 0)
+            DArray_swap(array, last, mid, temp);
+
+        // pivot parks at end - 2, start and last already bracket it
+        DArray_swap(array, mid, last - 1, temp);
+        int pivot = last - 1;
+        int i = start;
+        int j = pivot;
+
+        while (1) {
+            while (cmp(DArray_key(array, ++i), DArray_key(array, pivot)) < 0) {
+            }
+            while (cmp(DArray_key(array, --j), DArray_key(array, pivot)) > 0) {
+            }
+            if (i >= j) break;
+            DArray_swap(array, i, j, temp);
+        }
+
+        DArray_swap(array, i, pivot, temp);
+
+        // recurse on the smaller side, loop on the bigger one
+        if (i - start < end - i - 1) {
+            DArray_introsort(array, start, i, depth, cmp, temp);
+            start = i + 1;
+        } else {
+            DArray_introsort(array, i + 1, end, depth, cmp, temp);
+            end = i;
+        }
+    }
+
+    DArray_insertion_range(array, start, end, cmp, temp);
+}
+
+int DArray_qsort(DArray * array, List_compare cmp)
+{
+    char *temp = NULL;
+    int depth = 0;
+    int n = 0;
+
+    if (array->inline_values) {
+        temp = malloc(array->element_size);
+        check_mem(temp);
+    }
+
+    for (n = array->end; n > 1; n >>= 1) {
+        depth += 2;
+    }
+
+    DArray_introsort(array, 0, array->end, depth, cmp, temp);
+
+    free(temp);
+    return 0;
+
+error:
+    return -1;
+}
+
+int DArray_heapsort(DArray * array, List_compare cmp)
+{
+    char *temp = NULL;
+
+    if (array->inline_values) {
+        temp = malloc(array->element_size);
+        check_mem(temp);
+    }
+
+    DArray_heapsort_range(array, 0, array->end, cmp, temp);
+
+    free(temp);
+    return 0;
+
+error:
+    return -1;
+}
+
+DArray *List_to_darray(List * list)
+{
+    int max = List_count(list) > 0 ? List_count(list) : 1;
+    DArray *array = DArray_create(sizeof(void *), max);
+    check(array != NULL, "Failed to create darray.");
+
+    void **contents = array->contents;
+    LIST_FOREACH(list, first, next, cur) {
+        contents[array->end++] = cur->value;
+    }
+
+    return array;
+
+error:
+    return NULL;
+}
+
+List *DArray_to_list(DArray * array)
+{
+    int block = array->end > 0 ? array->end : 1;
+    // one pool block holds every node, so that's a single allocation
+    List *list = List_create_pooled(block);
+    int i = 0;
+
+    check(list != NULL, "Failed to create list.");
+
+    for (i = 0; i < array->end; i++) {
+        List_push(list, DArray_get(array, i));
+    }
+
+    return list;
+
+error:
+    return NULL;
+}
@@ -0,0 +1,114 @@
+#ifndef lcthw_DArray_h
+#define lcthw_DArray_h
+
+#include <stdlib.h>
+#include <assert.h>
+#include <lcthw/dbg.h>
+#include <lcthw/list_algos.h>
+
+/*
+ * Contiguous growable array. A plain DArray holds void * like List does.
+ * An inline DArray holds the elements themselves, element_size bytes
+ * each, and DArray_get hands out pointers into the array.
+ */
+
+typedef struct DArray {
+    int end;
+    int max;
+    size_t element_size;
+    size_t expand_rate;
+    int inline_values;
+    void *contents;
+} DArray;
+
+#define DEFAULT_EXPAND_RATE 300
+
+DArray *DArray_create(size_t element_size, size_t initial_max);
+DArray *DArray_create_inline(size_t element_size, size_t initial_max);
+
+void DArray_destroy(DArray * array);
+
+// frees the elements of a plain DArray, does nothing for inline ones
+void DArray_clear(DArray * array);
+
+int DArray_expand(DArray * array, int min_max);
+
+int DArray_shrink_to_fit(DArray * array);
+
+// plain: stores el, inline: copies element_size bytes from el
+int DArray_push(DArray * array, void *el);
+
+// inline: the element's slot, good until the next push
+void *DArray_pop(DArray * array);
+
+void DArray_clear_destroy(DArray * array);
+
+// cmp gets the stored pointers, or pointers to inline elements
+int DArray_qsort(DArray * array, List_compare cmp);
+int DArray_heapsort(DArray * array, List_compare cmp);
+
+DArray *List_to_darray(List * list);
+List *DArray_to_list(DArray * array);
+
+#define DArray_last(A) DArray_get((A), (A)->end - 1)
+#define DArray_first(A) DArray_get((A), 0)
+#define DArray_end(A) ((A)->end)
+#define DArray_count(A) DArray_end(A)
+#define DArray_max(A) ((A)->max)
+
+#define DArray_stride(A) ((A)->inline_values ?\
+        (A)->element_size : sizeof(void *))
+#define DArray_slot(A, I) ((char *)(A)->contents + (size_t)(I) * DArray_stride(A))
+
+static inline void DArray_set(DArray * array, int i, void *el)
+{
+    check(i < array->max, "darray attempt to set past max");
+
+    if (array->inline_values) {
+        memcpy(DArray_slot(array, i), el, array->element_size);
+    } else {
+        ((void **)array->contents)[i] = el;
+    }
+
+error:
+    return;
+}
+
+static inline void *DArray_get(DArray * array, int i)
+{
+    check(i < array->max, "darray attempt to get past max");
+
+    if (array->inline_values) {
+        return DArray_slot(array, i);
+    } else {
+        return ((void **)array->contents)[i];
+    }
+
+error:
+    return NULL;
+}
+
+static inline void *DArray_remove(DArray * array, int i)
+{
+    void *el = DArray_get(array, i);
+
+    if (!array->inline_values) {
+        ((void **)array->contents)[i] = NULL;
+    }
+
+    return el;
+}
+
+static inline void *DArray_new(DArray * array)
+{
+    check(array->element_size > 0, "Can't use DArray_new on 0 size darrays.");
+
+    return calloc(1, array->element_size);
+
+error:
+    return NULL;
+}
+
+#define DArray_free(E) free((E))
+
+#endif
@@ -0,0 +1,300 @@
+#include <lcthw/hashmap.h>
+#include <lcthw/dbg.h>
+#include <stdlib.h>
+
+// grow at 7/8 full, Robin Hood keeps probes short even that high
+#define HASHMAP_MAX_LOAD(C) ((C) - (C) / 8)
+// old table slots moved per set or delete during a resize
+#define HASHMAP_MIGRATE_STEP 8
+
+// entries of the old table that are gone keep their dist as tombstones
+static char hashmap_moved;
+#define HASHMAP_MOVED ((void *)&hashmap_moved)
+
+static int Hashmap_strcmp(const void *a, const void *b)
+{
+    return strcmp(a, b);
+}
+
+uint32_t Hashmap_fnv1a_hash(const void *key)
+{
+    const unsigned char *cur = key;
+    uint32_t hash = 2166136261u;
+
+    while (*cur != '\0') {
+        hash ^= *cur++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+Hashmap *Hashmap_create(Hashmap_compare compare, Hashmap_hash hash)
+{
+    Hashmap *map = calloc(1, sizeof(Hashmap));
+    check_mem(map);
+
+    map->compare = compare == NULL ? Hashmap_strcmp : compare;
+    map->hash = hash == NULL ? Hashmap_fnv1a_hash : hash;
+    map->capacity = HASHMAP_INITIAL_CAPACITY;
+    map->entries = calloc(map->capacity, sizeof(HashmapEntry));
+    check_mem(map->entries);
+
+    return map;
+
+error:
+    free(map);
+    return NULL;
+}
+
+void Hashmap_destroy(Hashmap * map)
+{
+    if (map) {
+        free(map->entries);
+        free(map->old);
+        free(map);
+    }
+}
+
+static void Hashmap_insert_entry(HashmapEntry * entries, int capacity,
+        HashmapEntry entry)
+{
+    uint32_t mask = capacity - 1;
+    uint32_t i = entry.hash & mask;
+
+    entry.dist = 1;
+
+    while (1) {
+        HashmapEntry *slot = &entries[i];
+
+        if (slot->dist == 0) {
+            *slot = entry;
+            return;
+        }
+
+        // take from the rich: whoever is closer to home moves on
+        if (slot->dist < entry.dist) {
+            HashmapEntry temp = *slot;
+            *slot = entry;
+            entry = temp;
+        }
+
+        i = (i + 1) & mask;
+        entry.dist++;
+    }
+}
+
+static HashmapEntry *Hashmap_find_entry(Hashmap * map, HashmapEntry * entries,
+        int capacity, void *key, uint32_t hash)
+{
+    uint32_t mask = capacity - 1;
+    uint32_t i = hash & mask;
+    uint32_t dist = 1;
+
+    while (1) {
+        HashmapEntry *slot = &entries[i];
+
+        // past where Robin Hood would have put it
+        if (slot->dist < dist) {
+            return NULL;
+        }
+
+        if (slot->hash == hash && slot->key != HASHMAP_MOVED &&
+                map->compare(slot->key, key) == 0) {
+            return slot;
+        }
+
+        i = (i + 1) & mask;
+        dist++;
+    }
+}
+
+// backward shift delete, so the table never needs tombstones
+static void Hashmap_remove_entry(HashmapEntry * entries, int capacity,
+        HashmapEntry * slot)
+{
+    uint32_t mask = capacity - 1;
+    uint32_t i = slot - entries;
+    uint32_t next = (i + 1) & mask;
+
+    while (entries[next].dist > 1) {
+        entries[i] = entries[next];
+        entries[i].dist--;
+        i = next;
+        next = (next + 1) & mask;
+    }
+
+    entries[i].dist = 0;
+    entries[i].key = NULL;
+    entries[i].data = NULL;
+}
+
+static void Hashmap_migrate(Hashmap * map, int slots)
+{
+    while (map->old != NULL && slots-- > 0) {
+        HashmapEntry *entry = &map->old[map->old_cursor++];
+
+        if (entry->dist > 0 && entry->key != HASHMAP_MOVED) {
+            Hashmap_insert_entry(map->entries, map->capacity, *entry);
+            entry->key = HASHMAP_MOVED;
+        }
+
+        if (map->old_cursor == map->old_capacity) {
+            free(map->old);
+            map->old = NULL;
+            map->old_capacity = 0;
+            map->old_cursor = 0;
+        }
+    }
+}
+
+static int Hashmap_grow(Hashmap * map)
+{
+    HashmapEntry *entries = NULL;
+
+    // a resize still going on has to finish before the next can start
+    Hashmap_migrate(map, map->old_capacity);
+
+    entries = calloc(map->capacity * 2, sizeof(HashmapEntry));
+    check_mem(entries);
+
+    map->old = map->entries;
+    map->old_capacity = map->capacity;
+    map->old_cursor = 0;
+    map->entries = entries;
+    map->capacity *= 2;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int Hashmap_set(Hashmap * map, void *key, void *data)
+{
+    uint32_t hash = map->hash(key);
+    HashmapEntry *entry = NULL;
+
+    Hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+
+    entry = Hashmap_find_entry(map, map->entries, map->capacity, key, hash);
+    if (entry != NULL) {
+        entry->data = data;
+        return 0;
+    }
+
+    if (map->old != NULL) {
+        entry = Hashmap_find_entry(map, map->old, map->old_capacity, key, hash);
+        if (entry != NULL) {
+            // set moves it across early instead of updating the old table
+            entry->key = HASHMAP_MOVED;
+            map->count--;
+        }
+    }
+
+    if (map->count + 1 > HASHMAP_MAX_LOAD(map->capacity)) {
+        check(Hashmap_grow(map) == 0, "Failed to grow the hashmap.");
+    }
+
+    HashmapEntry new_entry = { .key = key, .data = data, .hash = hash };
+    Hashmap_insert_entry(map->entries, map->capacity, new_entry);
+    map->count++;
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void *Hashmap_get(Hashmap * map, void *key)
+{
+    uint32_t hash = map->hash(key);
+    HashmapEntry *entry = Hashmap_find_entry(map, map->entries,
+            map->capacity, key, hash);
+
+    if (entry == NULL && map->old != NULL) {
+        entry = Hashmap_find_entry(map, map->old, map->old_capacity, key,
+                hash);
+    }
+
+    return entry != NULL ? entry->data : NULL;
+}
+
+void *Hashmap_delete(Hashmap * map, void *key)
+{
+    uint32_t hash = map->hash(key);
+    HashmapEntry *entry = NULL;
+    void *data = NULL;
+
+    Hashmap_migrate(map, HASHMAP_MIGRATE_STEP);
+
+    entry = Hashmap_find_entry(map, map->entries, map->capacity, key, hash);
+    if (entry != NULL) {
+        data = entry->data;
+        Hashmap_remove_entry(map->entries, map->capacity, entry);
+        map->count--;
+        return data;
+    }
+
+    if (map->old != NULL) {
+        entry = Hashmap_find_entry(map, map->old, map->old_capacity, key, hash);
+        if (entry != NULL) {
+            // shifting would move entries behind the migration cursor
+            data = entry->data;
+            entry->key = HASHMAP_MOVED;
+            map->count--;
+        }
+    }
+
+    return data;
+}
+
+void Hashmap_iter_init(Hashmap * map, HashmapIter * iter)
+{
+    iter->map = map;
+    iter->in_old = 0;
+    iter->index = 0;
+}
+
+HashmapEntry *Hashmap_iter_next(HashmapIter * iter)
+{
+    Hashmap *map = iter->map;
+
+    while (1) {
+        HashmapEntry *entries = iter->in_old ? map->old : map->entries;
+        int capacity = iter->in_old ? map->old_capacity : map->capacity;
+
+        while (entries != NULL && iter->index < capacity) {
+            HashmapEntry *entry = &entries[iter->index++];
+
+            if (entry->dist > 0 && entry->key != HASHMAP_MOVED) {
+                return entry;
+            }
+        }
+
+        if (iter->in_old) {
+            return NULL;
+        }
+
+        iter->in_old = 1;
+        iter->index = map->old_cursor;
+    }
+}
+
+int Hashmap_traverse(Hashmap * map, Hashmap_traverse_cb traverse_cb)
+{
+    HashmapIter iter;
+    HashmapEntry *entry = NULL;
+    int rc = 0;
+
+    Hashmap_iter_init(map, &iter);
+
+    while ((entry = Hashmap_iter_next(&iter)) != NULL) {
+        rc = traverse_cb(entry);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    return 0;
+}
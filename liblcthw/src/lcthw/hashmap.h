@@ -0,0 +1,67 @@
+#ifndef lcthw_Hashmap_h
+#define lcthw_Hashmap_h
+
+#include <stdint.h>
+
+/*
+ * Open addressing hash map with Robin Hood probing. Keys and values sit
+ * inline in one flat array of entries. When the table fills up, a
+ * table twice the size is allocated, and every set or delete after
+ * that moves a few entries across. No single call pays for a full
+ * rehash.
+ */
+
+#define HASHMAP_INITIAL_CAPACITY 16
+
+typedef int (*Hashmap_compare) (const void *a, const void *b);
+typedef uint32_t(*Hashmap_hash) (const void *key);
+
+typedef struct HashmapEntry {
+    void *key;
+    void *data;
+    uint32_t hash;
+    // distance from the home slot plus one, 0 is an empty slot
+    uint32_t dist;
+} HashmapEntry;
+
+typedef struct Hashmap {
+    HashmapEntry *entries;
+    int capacity;
+    int count;
+    // the table being drained into entries while a resize is going on
+    HashmapEntry *old;
+    int old_capacity;
+    int old_cursor;
+    Hashmap_compare compare;
+    Hashmap_hash hash;
+} Hashmap;
+
+typedef int (*Hashmap_traverse_cb) (HashmapEntry * entry);
+
+typedef struct HashmapIter {
+    Hashmap *map;
+    int in_old;
+    int index;
+} HashmapIter;
+
+// NULL compare and hash mean C string keys
+Hashmap *Hashmap_create(Hashmap_compare compare, Hashmap_hash hash);
+void Hashmap_destroy(Hashmap * map);
+
+#define Hashmap_count(A) ((A)->count)
+
+// replaces the data if key is already there
+int Hashmap_set(Hashmap * map, void *key, void *data);
+void *Hashmap_get(Hashmap * map, void *key);
+void *Hashmap_delete(Hashmap * map, void *key);
+
+// stops and returns the first non-zero the callback gives
+int Hashmap_traverse(Hashmap * map, Hashmap_traverse_cb traverse_cb);
+
+// no set or delete until the iteration is finished
+void Hashmap_iter_init(Hashmap * map, HashmapIter * iter);
+HashmapEntry *Hashmap_iter_next(HashmapIter * iter);
+
+uint32_t Hashmap_fnv1a_hash(const void *key);
+
+#endif
@@ -0,0 +1,95 @@
+#include <lcthw/ilist.h>
+#include <lcthw/dbg.h>
+
+IList *IList_create()
+{
+    return calloc(1, sizeof(IList));
+}
+
+void IList_destroy(IList * list)
+{
+    // the nodes belong to whoever embedded them
+    free(list);
+}
+
+void IList_push(IList * list, IListNode * node)
+{
+    check(node, "node can't be NULL");
+
+    node->next = NULL;
+    node->prev = list->last;
+
+    if (list->last == NULL) {
+        list->first = node;
+    } else {
+        list->last->next = node;
+    }
+
+    list->last = node;
+    list->count++;
+
+error:
+    return;
+}
+
+IListNode *IList_pop(IList * list)
+{
+    IListNode *node = list->last;
+    return node != NULL ? IList_remove(list, node) : NULL;
+}
+
+void IList_unshift(IList * list, IListNode * node)
+{
+    check(node, "node can't be NULL");
+
+    node->prev = NULL;
+    node->next = list->first;
+
+    if (list->first == NULL) {
+        list->last = node;
+    } else {
+        list->first->prev = node;
+    }
+
+    list->first = node;
+    list->count++;
+
+error:
+    return;
+}
+
+IListNode *IList_shift(IList * list)
+{
+    IListNode *node = list->first;
+    return node != NULL ? IList_remove(list, node) : NULL;
+}
+
+IListNode *IList_remove(IList * list, IListNode * node)
+{
+    check(list->first && list->last, "List is empty.");
+    check(node, "node can't be NULL");
+    // the ends are cheap to check, a node in the middle has to be trusted
+    check(node->prev != NULL || node == list->first, "Node is not on this list.");
+    check(node->next != NULL || node == list->last, "Node is not on this list.");
+
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->first = node->next;
+    }
+
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+
+    node->next = NULL;
+    node->prev = NULL;
+    list->count--;
+
+    return node;
+
+error:
+    return NULL;
+}
@@ -0,0 +1,56 @@
+#ifndef lcthw_IList_h
+#define lcthw_IList_h
+
+#include <stdlib.h>
+#include <stddef.h>
+
+/*
+ * Intrusive list: the links live inside the user's struct, so pushing
+ * allocates nothing.
+ *
+ *     typedef struct Conn { int fd; IListNode link; } Conn;
+ *     IList_push(queue, &conn->link);
+ *     IListNode *node = IList_shift(queue);
+ *     Conn *next = node != NULL ? IList_entry(node, Conn, link) : NULL;
+ *
+ * A node can only be on one IList at a time, and the list never frees
+ * the structs its nodes are embedded in.
+ */
+
+struct IListNode;
+
+typedef struct IListNode {
+    struct IListNode *next;
+    struct IListNode *prev;
+} IListNode;
+
+typedef struct IList {
+    int count;
+    IListNode *first;
+    IListNode *last;
+} IList;
+
+// recovers the struct T that holds node N in its member M, N can't be NULL
+#define IList_entry(N, T, M) ((T *)((char *)(N) - offsetof(T, M)))
+
+IList *IList_create();
+void IList_destroy(IList * list);
+
+#define IList_count(A) ((A)->count)
+#define IList_first(A) ((A)->first)
+#define IList_last(A) ((A)->last)
+
+void IList_push(IList * list, IListNode * node);
+IListNode *IList_pop(IList * list);
+
+void IList_unshift(IList * list, IListNode * node);
+IListNode *IList_shift(IList * list);
+
+// node must be on list, only the first and last are checked
+IListNode *IList_remove(IList * list, IListNode * node);
+
+#define ILIST_FOREACH(L, S, M, V) IListNode *_inode = NULL;\
+                                                    IListNode *V = NULL;\
+for(V = _inode = L->S; _inode != NULL; V = _inode = _inode->M)
+
+#endif
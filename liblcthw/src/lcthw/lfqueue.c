@@ -0,0 +1,311 @@
+#include <lcthw/lfqueue.h>
+#include <lcthw/dbg.h>
+#include <pthread.h>
+#include <stdint.h>
+
+/*
+ * Hazard pointers: before a thread dereferences a node it publishes the
+ * pointer in its record, and a removed node is only freed once no record
+ * holds it. Records are never freed, they're handed to the next thread
+ * when their owner exits, along with anything it still had retired.
+ */
+
+#define HAZARDS_PER_THREAD 2
+#define RETIRE_SCAN_MIN 64
+
+typedef struct HazardRecord {
+    _Atomic(void *) hazards[HAZARDS_PER_THREAD];
+    atomic_int active;
+    struct HazardRecord *next;
+    void **retired;
+    int nretired;
+    int max_retired;
+} HazardRecord;
+
+static _Atomic(HazardRecord *) hazard_records = NULL;
+static atomic_int hazard_nrecords = 0;
+static pthread_key_t hazard_key;
+static pthread_once_t hazard_once = PTHREAD_ONCE_INIT;
+static _Thread_local HazardRecord *hazard_mine = NULL;
+
+static int pointer_cmp(const void *a, const void *b)
+{
+    uintptr_t x = (uintptr_t) * (void *const *)a;
+    uintptr_t y = (uintptr_t) * (void *const *)b;
+    return (x > y) - (x < y);
+}
+
+// frees every retired node that no thread has a hazard pointer on
+static void HazardRecord_scan(HazardRecord * rec)
+{
+    int max = (atomic_load(&hazard_nrecords) + 1) * HAZARDS_PER_THREAD;
+    void **hazards = malloc(max * sizeof(void *));
+    HazardRecord *cur = NULL;
+    int nhazards = 0;
+    int kept = 0;
+    int i = 0;
+
+    check_mem(hazards);
+
+    for (cur = atomic_load(&hazard_records); cur != NULL; cur = cur->next) {
+        for (i = 0; i < HAZARDS_PER_THREAD; i++) {
+            void *hp = atomic_load(&cur->hazards[i]);
+
+            if (hp == NULL) {
+                continue;
+            }
+
+            // records can be added while we look, missing one isn't safe
+            if (nhazards == max) {
+                void **more = realloc(hazards, max * 2 * sizeof(void *));
+                check_mem(more);
+                hazards = more;
+                max *= 2;
+            }
+
+            hazards[nhazards++] = hp;
+        }
+    }
+
+    qsort(hazards, nhazards, sizeof(void *), pointer_cmp);
+
+    for (i = 0; i < rec->nretired; i++) {
+        void *node = rec->retired[i];
+
+        if (bsearch(&node, hazards, nhazards, sizeof(void *), pointer_cmp)) {
+            rec->retired[kept++] = node;
+        } else {
+            free(node);
+        }
+    }
+
+    rec->nretired = kept;
+
+error:          // fallthrough, on error nothing gets freed
+    free(hazards);
+}
+
+static void HazardRecord_release(void *arg)
+{
+    HazardRecord *rec = arg;
+    int i = 0;
+
+    for (i = 0; i < HAZARDS_PER_THREAD; i++) {
+        atomic_store(&rec->hazards[i], NULL);
+    }
+
+    HazardRecord_scan(rec);
+    atomic_store(&rec->active, 0);
+}
+
+static void Hazard_init()
+{
+    pthread_key_create(&hazard_key, HazardRecord_release);
+}
+
+static HazardRecord *HazardRecord_get()
+{
+    HazardRecord *rec = hazard_mine;
+
+    if (rec != NULL) {
+        return rec;
+    }
+
+    pthread_once(&hazard_once, Hazard_init);
+
+    // reuse a record some finished thread gave back
+    for (rec = atomic_load(&hazard_records); rec != NULL; rec = rec->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&rec->active, &expected, 1)) {
+            break;
+        }
+    }
+
+    if (rec == NULL) {
+        rec = calloc(1, sizeof(HazardRecord));
+        check_mem(rec);
+
+        atomic_store(&rec->active, 1);
+        atomic_fetch_add(&hazard_nrecords, 1);
+
+        HazardRecord *head = atomic_load(&hazard_records);
+        do {
+            rec->next = head;
+        } while (!atomic_compare_exchange_weak(&hazard_records, &head, rec));
+    }
+
+    pthread_setspecific(hazard_key, rec);
+    hazard_mine = rec;
+
+error:          // fallthrough
+    return rec;
+}
+
+static void HazardRecord_retire(HazardRecord * rec, void *node)
+{
+    if (rec->nretired == rec->max_retired) {
+        int max = rec->max_retired ? rec->max_retired * 2 : RETIRE_SCAN_MIN;
+        void **retired = realloc(rec->retired, max * sizeof(void *));
+
+        if (retired == NULL) {
+            // can't track it, leaking beats a use after free
+            log_err("Out of memory retiring a queue node.");
+            return;
+        }
+
+        rec->retired = retired;
+        rec->max_retired = max;
+    }
+
+    rec->retired[rec->nretired++] = node;
+
+    if (rec->nretired >= RETIRE_SCAN_MIN &&
+            rec->nretired >= 2 * HAZARDS_PER_THREAD *
+            atomic_load(&hazard_nrecords)) {
+        HazardRecord_scan(rec);
+    }
+}
+
+// loads *src and publishes it as hazard i, retrying until that sticks
+static LFQueueNode *HazardRecord_protect(HazardRecord * rec, int i,
+        _Atomic(LFQueueNode *) * src)
+{
+    LFQueueNode *node = atomic_load(src);
+    LFQueueNode *again = NULL;
+
+    while (1) {
+        atomic_store(&rec->hazards[i], node);
+        again = atomic_load(src);
+
+        if (again == node) {
+            return node;
+        }
+
+        node = again;
+    }
+}
+
+static void HazardRecord_clear(HazardRecord * rec)
+{
+    atomic_store(&rec->hazards[0], NULL);
+    atomic_store(&rec->hazards[1], NULL);
+}
+
+LFQueue *LFQueue_create()
+{
+    LFQueue *queue = calloc(1, sizeof(LFQueue));
+    check_mem(queue);
+
+    // the queue always holds a dummy node, head points at it
+    LFQueueNode *dummy = calloc(1, sizeof(LFQueueNode));
+    check_mem(dummy);
+
+    atomic_init(&dummy->next, NULL);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    atomic_init(&queue->count, 0);
+
+    return queue;
+
+error:
+    free(queue);
+    return NULL;
+}
+
+void LFQueue_destroy(LFQueue * queue)
+{
+    LFQueueNode *node = atomic_load(&queue->head);
+
+    while (node != NULL) {
+        LFQueueNode *next = atomic_load(&node->next);
+        free(node);
+        node = next;
+    }
+
+    free(queue);
+}
+
+int LFQueue_push(LFQueue * queue, void *value)
+{
+    HazardRecord *rec = HazardRecord_get();
+    LFQueueNode *node = NULL;
+
+    check(rec != NULL, "Failed to get a hazard record.");
+
+    node = malloc(sizeof(LFQueueNode));
+    check_mem(node);
+
+    node->value = value;
+    atomic_init(&node->next, NULL);
+
+    while (1) {
+        LFQueueNode *tail = HazardRecord_protect(rec, 0, &queue->tail);
+        LFQueueNode *next = atomic_load(&tail->next);
+
+        if (tail != atomic_load(&queue->tail)) {
+            continue;
+        }
+
+        if (next != NULL) {
+            // another push is half done, help it move the tail along
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak(&tail->next, &next, node)) {
+            atomic_compare_exchange_strong(&queue->tail, &tail, node);
+            break;
+        }
+    }
+
+    HazardRecord_clear(rec);
+    atomic_fetch_add(&queue->count, 1);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+void *LFQueue_shift(LFQueue * queue)
+{
+    HazardRecord *rec = HazardRecord_get();
+    LFQueueNode *head = NULL;
+    void *value = NULL;
+
+    check(rec != NULL, "Failed to get a hazard record.");
+
+    while (1) {
+        head = HazardRecord_protect(rec, 0, &queue->head);
+        LFQueueNode *tail = atomic_load(&queue->tail);
+        LFQueueNode *next = HazardRecord_protect(rec, 1, &head->next);
+
+        if (head != atomic_load(&queue->head)) {
+            continue;
+        }
+
+        if (next == NULL) {
+            HazardRecord_clear(rec);
+            return NULL;
+        }
+
+        if (head == tail) {
+            atomic_compare_exchange_weak(&queue->tail, &tail, next);
+            continue;
+        }
+
+        // next becomes the new dummy, its value is ours
+        value = next->value;
+
+        if (atomic_compare_exchange_weak(&queue->head, &head, next)) {
+            break;
+        }
+    }
+
+    HazardRecord_clear(rec);
+    HazardRecord_retire(rec, head);
+    atomic_fetch_sub(&queue->count, 1);
+
+error:          // fallthrough
+    return value;
+}
@@ -0,0 +1,42 @@
+#ifndef lcthw_LFQueue_h
+#define lcthw_LFQueue_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/*
+ * Lock-free multi-producer, multi-consumer FIFO with the List_push and
+ * List_shift semantics. It's a Michael-Scott queue, and removed nodes
+ * are reclaimed with hazard pointers, so any number of threads can
+ * push and shift at once without a mutex.
+ */
+
+struct LFQueueNode;
+
+typedef struct LFQueueNode {
+    _Atomic(struct LFQueueNode *) next;
+    void *value;
+} LFQueueNode;
+
+typedef struct LFQueue {
+    // head and tail on separate cache lines so consumers and producers
+    // don't fight over one
+    _Atomic(LFQueueNode *) head;
+    char _pad1[64 - sizeof(LFQueueNode *)];
+    _Atomic(LFQueueNode *) tail;
+    char _pad2[64 - sizeof(LFQueueNode *)];
+    atomic_int count;
+} LFQueue;
+
+LFQueue *LFQueue_create();
+// only call once no other thread is using the queue
+void LFQueue_destroy(LFQueue * queue);
+
+// a snapshot, other threads may have changed it by the time you look
+#define LFQueue_count(A) atomic_load(&(A)->count)
+
+int LFQueue_push(LFQueue * queue, void *value);
+// NULL when the queue is empty, so don't push NULL values
+void *LFQueue_shift(LFQueue * queue);
+
+#endif
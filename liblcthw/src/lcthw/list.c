@@ -1,13 +1,194 @@
 #include <lcthw/list.h>
 #include <lcthw/dbg.h>
+#include <pthread.h>
+
+typedef struct ListPoolBlock {
+    struct ListPoolBlock *next;
+    ListNode nodes[];
+} ListPoolBlock;
+
+typedef struct ListPool {
+    int block_size;
+    // nodes handed out of, and nodes in, the newest block
+    int used;
+    int capacity;
+    // lists using the pool, it only locks once there's more than one
+    int refs;
+    int shared;
+    pthread_mutex_t lock;
+    ListPoolBlock *blocks;
+    ListNode *free;
+} ListPool;
+
+static inline void ListPool_lock(ListPool * pool)
+{
+    if (pool->shared) {
+        pthread_mutex_lock(&pool->lock);
+    }
+}
+
+static inline void ListPool_unlock(ListPool * pool)
+{
+    if (pool->shared) {
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
 
 List *List_create()
 {
     return calloc(1, sizeof(List));
 }
 
+List *List_create_pooled(int block_size)
+{
+    List *list = NULL;
+
+    check(block_size > 0, "Invalid block_size %d, must be > 0.", block_size);
+
+    list = List_create();
+    check_mem(list);
+
+    list->pool = calloc(1, sizeof(ListPool));
+    check_mem(list->pool);
+
+    list->pool->block_size = block_size;
+    list->pool->refs = 1;
+    pthread_mutex_init(&list->pool->lock, NULL);
+
+    return list;
+
+error:
+    free(list);
+    return NULL;
+}
+
+List *List_create_sharing(List * list)
+{
+    List *other = List_create();
+    check_mem(other);
+
+    if (list->pool != NULL) {
+        // set before other can reach another thread, so it's never racy
+        if (!list->pool->shared) {
+            list->pool->shared = 1;
+        }
+
+        ListPool_lock(list->pool);
+        list->pool->refs++;
+        ListPool_unlock(list->pool);
+
+        other->pool = list->pool;
+    }
+
+error:          // fallthrough
+    return other;
+}
+
+// a new newest block of at least n nodes, the last one's leftovers go free
+static int ListPool_grow(ListPool * pool, int n)
+{
+    int capacity = n > pool->block_size ? n : pool->block_size;
+    ListPoolBlock *block = calloc(1, sizeof(ListPoolBlock) +
+            capacity * sizeof(ListNode));
+    check_mem(block);
+
+    while (pool->used < pool->capacity) {
+        ListNode *node = &pool->blocks->nodes[pool->used++];
+        node->next = pool->free;
+        pool->free = node;
+    }
+
+    block->next = pool->blocks;
+    pool->blocks = block;
+    pool->used = 0;
+    pool->capacity = capacity;
+    return 0;
+
+error:
+    return -1;
+}
+
+static inline ListNode *ListNode_alloc(List * list)
+{
+    ListPool *pool = list->pool;
+    ListNode *node = NULL;
+
+    if (pool == NULL) {
+        return calloc(1, sizeof(ListNode));
+    }
+
+    ListPool_lock(pool);
+
+    if (pool->free != NULL) {
+        // recycled nodes have to look like they came from calloc
+        node = pool->free;
+        pool->free = node->next;
+        node->next = NULL;
+        node->prev = NULL;
+        node->value = NULL;
+    } else if (pool->used < pool->capacity || ListPool_grow(pool, 1) == 0) {
+        node = &pool->blocks->nodes[pool->used++];
+    }
+
+    ListPool_unlock(pool);
+    check_mem(node);
+
+error:          // fallthrough
+    return node;
+}
+
+static inline void ListNode_free(List * list, ListNode * node)
+{
+    if (list->pool == NULL) {
+        free(node);
+    } else {
+        ListPool_lock(list->pool);
+        node->next = list->pool->free;
+        list->pool->free = node;
+        ListPool_unlock(list->pool);
+    }
+}
+
+// the blocks go with the last list using the pool
+static void ListPool_release(ListPool * pool, ListNode * first,
+        ListNode * last)
+{
+    ListPoolBlock *block = NULL;
+
+    ListPool_lock(pool);
+
+    if (--pool->refs > 0) {
+        // the chain is already linked by next, it goes on the free list whole
+        if (first != NULL) {
+            last->next = pool->free;
+            pool->free = first;
+        }
+
+        ListPool_unlock(pool);
+        return;
+    }
+
+    ListPool_unlock(pool);
+
+    block = pool->blocks;
+    while (block != NULL) {
+        ListPoolBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
 void List_destroy(List * list)
 {
+    if (list->pool != NULL) {
+        ListPool_release(list->pool, list->first, list->last);
+        free(list);
+        return;
+    }
+
     LIST_FOREACH(list, first, next, cur) {
         if (cur->prev) {
             free(cur->prev);
@@ -33,7 +214,7 @@ void List_clear_destroy(List * list)
 
 void List_push(List * list, void *value)
 {
-    ListNode *node = calloc(1, sizeof(ListNode));
+    ListNode *node = ListNode_alloc(list);
     check_mem(node);
 
     node->value = value;
@@ -61,7 +242,7 @@ void *List_pop(List * list)
 
 void List_unshift(List * list, void *value)
 {
-    ListNode *node = calloc(1, sizeof(ListNode));
+    ListNode *node = ListNode_alloc(list);
     check_mem(node);
 
     node->value = value;
@@ -116,8 +297,192 @@ void *List_remove(List * list, ListNode * node)
 
     list->count--;
     result = node->value;
-    free(node);
+    ListNode_free(list, node);
 
 error:
     return result;
-}
\ No newline at end of file
+}
+
+int List_push_many(List * list, void **values, int n)
+{
+    ListPool *pool = list->pool;
+    ListNode *nodes = NULL;
+    int i = 0;
+
+    check(n >= 0, "Invalid count %d.", n);
+
+    if (pool == NULL) {
+        // every node has to be its own allocation to be freed on its own
+        for (i = 0; i < n; i++) {
+            int count = list->count;
+            List_push(list, values[i]);
+            check(list->count > count, "Failed to push value %d of %d.", i, n);
+        }
+
+        return 0;
+    }
+
+    if (n == 0) {
+        return 0;
+    }
+
+    ListPool_lock(pool);
+    if (pool->capacity - pool->used >= n || ListPool_grow(pool, n) == 0) {
+        nodes = &pool->blocks->nodes[pool->used];
+        pool->used += n;
+    }
+    ListPool_unlock(pool);
+    check_mem(nodes);
+
+    for (i = 0; i < n; i++) {
+        nodes[i].value = values[i];
+        nodes[i].prev = i > 0 ? &nodes[i - 1] : list->last;
+        nodes[i].next = i < n - 1 ? &nodes[i + 1] : NULL;
+    }
+
+    if (list->last == NULL) {
+        list->first = nodes;
+    } else {
+        list->last->next = nodes;
+    }
+
+    list->last = &nodes[n - 1];
+    list->count += n;
+    return 0;
+
+error:
+    return -1;
+}
+
+static inline int List_same_nodes(List * a, List * b)
+{
+    return a->pool == b->pool;
+}
+
+static int List_chain_count(ListNode * first, ListNode * last)
+{
+    int count = 1;
+
+    for (; first != last; first = first->next) {
+        count++;
+    }
+
+    return count;
+}
+
+// takes the chain first..last out of list, it keeps its inner links
+static void List_unlink(List * list, ListNode * first, ListNode * last,
+        int count)
+{
+    if (first->prev == NULL) {
+        list->first = last->next;
+    } else {
+        first->prev->next = last->next;
+    }
+
+    if (last->next == NULL) {
+        list->last = first->prev;
+    } else {
+        last->next->prev = first->prev;
+    }
+
+    first->prev = NULL;
+    last->next = NULL;
+    list->count -= count;
+}
+
+// puts the chain first..last in front of before, or at the end on NULL
+static void List_link(List * list, ListNode * before, ListNode * first,
+        ListNode * last, int count)
+{
+    ListNode *after = before != NULL ? before->prev : list->last;
+
+    first->prev = after;
+    last->next = before;
+
+    if (after == NULL) {
+        list->first = first;
+    } else {
+        after->next = first;
+    }
+
+    if (before == NULL) {
+        list->last = last;
+    } else {
+        before->prev = last;
+    }
+
+    list->count += count;
+}
+
+int List_splice(List * to, ListNode * before, List * from, ListNode * first,
+        ListNode * last, int count)
+{
+    ListNode *node = NULL;
+    ListNode *next = NULL;
+
+    check(first != NULL && last != NULL, "Need a range to splice.");
+
+    if (count < 0) {
+        count = List_chain_count(first, last);
+    }
+
+    if (List_same_nodes(to, from)) {
+        List_unlink(from, first, last, count);
+        List_link(to, before, first, last, count);
+        return 0;
+    }
+
+    // nodes from another pool can't move, their values get new nodes here
+    for (node = first; count > 0; node = next, count--) {
+        ListNode *copy = ListNode_alloc(to);
+        check_mem(copy);
+
+        next = node->next;
+        copy->value = node->value;
+        List_link(to, before, copy, copy, 1);
+        List_remove(from, node);
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+int List_join(List * list, List * other)
+{
+    check(list != other, "Can't join a list to itself.");
+
+    if (other->first == NULL) {
+        return 0;
+    }
+
+    return List_splice(list, NULL, other, other->first, other->last,
+            other->count);
+
+error:
+    return -1;
+}
+
+List *List_split_at(List * list, ListNode * node, int count)
+{
+    List *rest = List_create_sharing(list);
+    check(rest != NULL, "Failed to create the split off list.");
+
+    if (node != NULL) {
+        ListNode *last = list->last;
+
+        if (count < 0) {
+            count = List_chain_count(node, last);
+        }
+
+        List_unlink(list, node, last, count);
+        List_link(rest, NULL, node, last, count);
+    }
+
+    return rest;
+
+error:
+    return NULL;
+}
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 
 struct ListNode;
+struct ListPool;
 
 typedef struct ListNode {
     struct ListNode *next;
@@ -15,13 +16,24 @@ typedef struct List {
     int count;
     ListNode *first;
     ListNode *last;
+    struct ListPool *pool;
 } List;
 
 List *List_create();
+// nodes are carved out of blocks of block_size and recycled on remove
+List *List_create_pooled(int block_size);
 void List_destroy(List * list);
 void List_clear(List * list);
 void List_clear_destroy(List * list);
 
+/*
+ * An empty list that takes its nodes from the same place list does, so
+ * nodes move between the two without being copied. Pooled lists share
+ * the pool, which locks from then on so they can be on different
+ * threads, and it's freed with the last of them.
+ */
+List *List_create_sharing(List * list);
+
 #define List_count(A) ((A)->count)
 #define List_first(A) ((A)->first != NULL ? (A)->first->value : NULL)
 #define List_last(A) ((A)->last != NULL ? (A)->last->value : NULL)
@@ -34,6 +46,28 @@ void *List_shift(List * list);
 
 void *List_remove(List * list, ListNode * node);
 
+// on a pooled list the n nodes are one allocation, or none at all
+int List_push_many(List * list, void **values, int n);
+
+/*
+ * Moves first..last out of from and in front of before in to, or onto
+ * its end if before is NULL. O(1) between lists that share nodes, given
+ * count, which is how many nodes the range has, or < 0 to walk it and
+ * count. Otherwise every value needs a new node and it's O(count).
+ * to and from can be the same list, as long as before isn't in the range.
+ */
+int List_splice(List * to, ListNode * before, List * from, ListNode * first,
+        ListNode * last, int count);
+
+// other's nodes go on the end of list, other ends up empty
+int List_join(List * list, List * other);
+
+/*
+ * node and everything after it move to a new list sharing list's nodes,
+ * count is how many that is, or < 0 to have it counted.
+ */
+List *List_split_at(List * list, ListNode * node, int count);
+
 #define LIST_FOREACH(L, S, M, V) ListNode *_node = NULL;\
                                                    ListNode *V = NULL;\
 for(V = _node = L->S; _node != NULL; V = _node = _node->M)
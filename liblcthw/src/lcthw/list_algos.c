@@ -1,7 +1,26 @@
 #include <lcthw/list_algos.h>
+#include <lcthw/darray.h>
+#include <lcthw/threadpool.h>
 #include <lcthw/dbg.h>
+#include <pthread.h>
 
-inline void ListNode_swap(ListNode * a, ListNode * b)
+#define LIST_PARALLEL_MAX_THREADS 64
+#define LIST_MIN_GALLOP 7
+#define LIST_MAX_RUNS 64
+#define LIST_RADIX_BUCKETS 256
+#define LIST_RADIX_CUTOFF 16
+#define LIST_SELECT_CUTOFF 16
+#define LIST_SELECT_SAMPLES 15
+
+#if defined(__GNUC__)
+#define LIST_PREFETCH(P) __builtin_prefetch(P)
+#else
+#define LIST_PREFETCH(P)
+#endif
+
+int List_parallel_threshold = 65536;
+
+static inline void ListNode_swap(ListNode * a, ListNode * b)
 {
     void *temp = a->value;
     a->value = b->value;
@@ -31,66 +50,1668 @@ int List_bubble_sort(List * list, List_compare cmp)
     return 0;
 }
 
-inline List *List_merge(List * left, List * right, List_compare cmp)
+/*
+ * Stable merge of two NULL terminated next chains, prev is left for
+ * List_relink to fix once the whole sort is done.
+ */
+static inline ListNode *ListNode_merge(ListNode * left, ListNode * right,
+        List_compare cmp)
 {
-    List *result = List_create();
-    void *val = NULL;
+    ListNode head = { .next = NULL };
+    ListNode *tail = &head;
 
-    while (List_count(left) > 0 || List_count(right) > 0) {
-        if (List_count(left) > 0 && List_count(right) > 0) {
-            if(cmp(List_first(left), List_first(right)) <= 0) {
-                val = List_shift(left);
-            } else {
-                val = List_shift(right);
-            }
+    while (left != NULL && right != NULL) {
+        if (cmp(left->value, right->value) <= 0) {
+            tail->next = left;
+            left = left->next;
+        } else {
+            tail->next = right;
+            right = right->next;
+        }
+
+        tail = tail->next;
+    }
+
+    tail->next = left != NULL ? left : right;
+
+    return head.next;
+}
+
+/*
+ * Bottom-up merge sort of a NULL terminated chain. bins[i] is either
+ * empty or holds a sorted run of 2^i nodes, so adding a node works like
+ * incrementing a binary counter and no extra memory is needed.
+ */
+static ListNode *ListNode_sort(ListNode * head, List_compare cmp)
+{
+    ListNode *bins[64] = { NULL };
+    ListNode *result = NULL;
+    int max_bin = 0;
+    int i = 0;
+
+    while (head != NULL) {
+        ListNode *run = head;
+        head = head->next;
+        run->next = NULL;
+
+        // older runs go on the left to keep the sort stable
+        for (i = 0; bins[i] != NULL; i++) {
+            run = ListNode_merge(bins[i], run, cmp);
+            bins[i] = NULL;
+        }
+
+        bins[i] = run;
+        if (i > max_bin) {
+            max_bin = i;
+        }
+    }
 
-            List_push(result, val);
-        } else if (List_count(left) > 0) {
-            val = List_shift(left);
-            List_push(result, val);
-        } else if (List_count(right) > 0) {
-            val = List_shift(right);
-            List_push(result, val);
+    for (i = 0; i <= max_bin; i++) {
+        if (bins[i] != NULL) {
+            result = ListNode_merge(bins[i], result, cmp);
         }
     }
 
     return result;
 }
 
-List *List_merge_sort(List * list, List_compare cmp)
+// rebuilds prev, first and last from a sorted next chain
+static void List_relink(List * list, ListNode * head)
 {
-    List *result = NULL;
+    ListNode *prev = NULL;
+    ListNode *node = NULL;
+
+    list->first = head;
+
+    for (node = head; node != NULL; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+
+    list->last = prev;
+}
 
+List *List_merge_sort(List * list, List_compare cmp)
+{
     if (List_count(list) <= 1) {
         return list;
     }
 
-    List *left = List_create();
-    List *right = List_create();
-    int middle = List_count(list) / 2;
+    List_relink(list, ListNode_sort(list->first, cmp));
+
+    return list;
+}
+
+typedef struct ListRun {
+    ListNode *head;
+    ListNode *tail;
+    int len;
+} ListRun;
+
+// same rule as Timsort: n/minrun is a power of two or just below one
+static int List_min_run(int n)
+{
+    int r = 0;
+
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+
+    return n + r;
+}
+
+static inline int ListNode_goes_before(ListNode * node, void *key,
+        List_compare cmp, int inclusive)
+{
+    int rc = cmp(node->value, key);
+    return inclusive ? rc <= 0 : rc < 0;
+}
+
+/*
+ * Counts how many of the len nodes starting at start go before key and
+ * puts the last of them in *last. It compares at positions 1, 2, 4, 8...
+ * and then binary searches the last gap, so the walk is linear but the
+ * comparisons are only logarithmic in the answer.
+ */
+static int ListNode_gallop(ListNode * start, int len, void *key,
+        List_compare cmp, int inclusive, ListNode ** last)
+{
+    ListNode *lo = NULL;
+    ListNode *probe = start;
+    int lo_n = 0;
+    int probe_n = 1;
+    int step = 1;
+
+    while (ListNode_goes_before(probe, key, cmp, inclusive)) {
+        lo = probe;
+        lo_n = probe_n;
+
+        if (probe_n == len) {
+            *last = lo;
+            return len;
+        }
+
+        int next_n = probe_n + step < len ? probe_n + step : len;
+        while (probe_n < next_n) {
+            probe = probe->next;
+            probe_n++;
+        }
+
+        step *= 2;
+    }
+
+    int hi_n = probe_n;
+    while (hi_n - lo_n > 1) {
+        int mid_n = lo_n + (hi_n - lo_n) / 2;
+        ListNode *mid = lo != NULL ? lo : start;
+        int hops = lo != NULL ? mid_n - lo_n : mid_n - 1;
+
+        while (hops-- > 0) {
+            mid = mid->next;
+        }
+
+        if (ListNode_goes_before(mid, key, cmp, inclusive)) {
+            lo = mid;
+            lo_n = mid_n;
+        } else {
+            hi_n = mid_n;
+        }
+    }
+
+    *last = lo;
+    return lo_n;
+}
+
+/*
+ * Merges two adjacent runs, a before b. Runs that are already in order
+ * are joined in O(1), and once one side keeps winning the merge gallops
+ * over it and splices the whole stretch in with a single link.
+ */
+static ListRun ListRun_merge(ListRun a, ListRun b, List_compare cmp)
+{
+    ListNode head = { .next = NULL };
+    ListNode *tail = &head;
+    ListNode *x = a.head;
+    ListNode *y = b.head;
+    ListNode *last = NULL;
+    int na = a.len;
+    int nb = b.len;
+    // start out galloping to skip the prefix of a that is already in place
+    int wins_a = LIST_MIN_GALLOP;
+    int wins_b = 0;
+    int k = 0;
+
+    if (cmp(a.tail->value, b.head->value) <= 0) {
+        a.tail->next = b.head;
+        a.tail = b.tail;
+        a.len += b.len;
+        return a;
+    }
+
+    while (na > 0 && nb > 0) {
+        if (wins_a >= LIST_MIN_GALLOP) {
+            k = ListNode_gallop(x, na, y->value, cmp, 1, &last);
+            if (k > 0) {
+                tail->next = x;
+                tail = last;
+                x = last->next;
+                na -= k;
+            }
+            // a good gallop means b probably comes in a long stretch too
+            wins_a = 0;
+            wins_b = k >= LIST_MIN_GALLOP ? LIST_MIN_GALLOP : 0;
+            continue;
+        }
+
+        if (wins_b >= LIST_MIN_GALLOP) {
+            // b only goes first when strictly smaller, that keeps it stable
+            k = ListNode_gallop(y, nb, x->value, cmp, 0, &last);
+            if (k > 0) {
+                tail->next = y;
+                tail = last;
+                y = last->next;
+                nb -= k;
+            }
+            wins_b = 0;
+            wins_a = k >= LIST_MIN_GALLOP ? LIST_MIN_GALLOP : 0;
+            continue;
+        }
+
+        if (cmp(x->value, y->value) <= 0) {
+            tail->next = x;
+            tail = x;
+            x = x->next;
+            na--;
+            wins_a++;
+            wins_b = 0;
+        } else {
+            tail->next = y;
+            tail = y;
+            y = y->next;
+            nb--;
+            wins_b++;
+            wins_a = 0;
+        }
+    }
+
+    ListRun result = { .head = head.next, .len = a.len + b.len };
+
+    if (na > 0) {
+        tail->next = x;
+        result.tail = a.tail;
+    } else {
+        tail->next = y;
+        result.tail = b.tail;
+    }
+
+    result.tail->next = NULL;
+
+    return result;
+}
+
+// sorts up to len nodes off the front of *rest into a run of their own
+static ListRun ListRun_take(ListNode ** rest, int len, List_compare cmp)
+{
+    ListRun run = { .head = *rest, .tail = *rest, .len = 1 };
+
+    while (run.len < len && run.tail->next != NULL) {
+        run.tail = run.tail->next;
+        run.len++;
+    }
+
+    *rest = run.tail->next;
+    run.tail->next = NULL;
+
+    run.head = ListNode_sort(run.head, cmp);
+    for (run.tail = run.head; run.tail->next != NULL; run.tail = run.tail->next) {
+    }
+
+    return run;
+}
+
+/*
+ * Cuts the next natural run off the front of *rest. Strictly descending
+ * runs are reversed, which can't reorder equal elements.
+ */
+static ListRun ListRun_next(ListNode ** rest, List_compare cmp)
+{
+    ListRun run = { .head = *rest, .tail = *rest, .len = 1 };
+    ListNode *cur = run.head->next;
+
+    if (cur != NULL && cmp(cur->value, run.head->value) < 0) {
+        ListNode *reversed = run.head;
+        reversed->next = NULL;
+
+        while (cur != NULL && cmp(cur->value, reversed->value) < 0) {
+            ListNode *next = cur->next;
+            cur->next = reversed;
+            reversed = cur;
+            cur = next;
+            run.len++;
+        }
+
+        run.head = reversed;
+    } else {
+        while (cur != NULL && cmp(run.tail->value, cur->value) <= 0) {
+            run.tail = cur;
+            cur = cur->next;
+            run.len++;
+        }
+
+        run.tail->next = NULL;
+    }
+
+    *rest = cur;
+    return run;
+}
+
+static void ListRun_merge_at(ListRun * runs, int *nruns, int i,
+        List_compare cmp)
+{
+    runs[i] = ListRun_merge(runs[i], runs[i + 1], cmp);
+
+    if (i + 2 < *nruns) {
+        runs[i + 1] = runs[i + 2];
+    }
+
+    (*nruns)--;
+}
+
+// keeps run lengths growing like Fibonacci numbers so merges stay balanced
+static void ListRun_collapse(ListRun * runs, int *nruns, List_compare cmp)
+{
+    while (*nruns > 1) {
+        int k = *nruns - 2;
+
+        if ((k > 0 && runs[k - 1].len <= runs[k].len + runs[k + 1].len) ||
+                (k > 1 && runs[k - 2].len <= runs[k - 1].len + runs[k].len)) {
+            if (runs[k - 1].len < runs[k + 1].len) {
+                k--;
+            }
+        } else if (runs[k].len > runs[k + 1].len) {
+            break;
+        }
+
+        ListRun_merge_at(runs, nruns, k, cmp);
+    }
+}
+
+int List_tim_sort(List * list, List_compare cmp)
+{
+    ListRun runs[LIST_MAX_RUNS];
+    ListNode *rest = list->first;
+    int nruns = 0;
+    int min_run = 0;
+
+    if (List_count(list) <= 1) {
+        return 0;
+    }
+
+    min_run = List_min_run(List_count(list));
+
+    while (rest != NULL) {
+        ListRun run = ListRun_next(&rest, cmp);
+
+        // short natural runs are topped up to min_run with a sorted chunk
+        if (run.len < min_run && rest != NULL) {
+            ListRun chunk = ListRun_take(&rest, min_run - run.len, cmp);
+            run = ListRun_merge(run, chunk, cmp);
+        }
+
+        runs[nruns++] = run;
+        ListRun_collapse(runs, &nruns, cmp);
+    }
+
+    while (nruns > 1) {
+        int k = nruns - 2;
+        if (k > 0 && runs[k - 1].len < runs[k + 1].len) {
+            k--;
+        }
+        ListRun_merge_at(runs, &nruns, k, cmp);
+    }
+
+    List_relink(list, runs[0].head);
+
+    return 0;
+}
+
+// stable insertion sort for the small buckets MSD leaves behind
+static ListNode *ListNode_insertion_u64(ListNode * head, List_key key,
+        ListNode ** tail)
+{
+    ListNode *sorted = NULL;
+    ListNode *last = NULL;
+
+    while (head != NULL) {
+        ListNode *node = head;
+        head = head->next;
+        node->next = NULL;
+
+        uint64_t k = key(node->value);
+
+        if (last == NULL || key(last->value) <= k) {
+            if (last == NULL) {
+                sorted = node;
+            } else {
+                last->next = node;
+            }
+            last = node;
+        } else if (key(sorted->value) > k) {
+            node->next = sorted;
+            sorted = node;
+        } else {
+            ListNode *cur = sorted;
+            while (key(cur->next->value) <= k) {
+                cur = cur->next;
+            }
+            node->next = cur->next;
+            cur->next = node;
+        }
+    }
+
+    *tail = last;
+    return sorted;
+}
+
+/*
+ * Deals the chain out into 256 buckets on the byte at shift and sorts
+ * each bucket on the next byte down. After the first split the buckets
+ * fit in cache, which an LSD pass over the whole list never does.
+ * Appending to bucket tails keeps it stable.
+ */
+static ListNode *ListNode_radix_u64(ListNode * head, int len, List_key key,
+        int shift, ListNode ** tail)
+{
+    ListNode *heads[LIST_RADIX_BUCKETS];
+    ListNode *tails[LIST_RADIX_BUCKETS] = { NULL };
+    int counts[LIST_RADIX_BUCKETS] = { 0 };
+    ListNode *result = NULL;
+    ListNode *last = NULL;
+    int i = 0;
+
+    if (len <= LIST_RADIX_CUTOFF) {
+        return ListNode_insertion_u64(head, key, tail);
+    }
+
+    while (head != NULL) {
+        int b = (key(head->value) >> shift) & 0xff;
+
+        if (tails[b] == NULL) {
+            heads[b] = head;
+        } else {
+            tails[b]->next = head;
+        }
+
+        tails[b] = head;
+        counts[b]++;
+        head = head->next;
+    }
+
+    for (i = 0; i < LIST_RADIX_BUCKETS; i++) {
+        if (tails[i] == NULL) {
+            continue;
+        }
+
+        ListNode *bucket = heads[i];
+        ListNode *bucket_tail = tails[i];
+        bucket_tail->next = NULL;
+
+        if (shift > 0 && counts[i] > 1) {
+            bucket = ListNode_radix_u64(bucket, counts[i], key, shift - 8,
+                    &bucket_tail);
+        }
+
+        if (last == NULL) {
+            result = bucket;
+        } else {
+            last->next = bucket;
+        }
+
+        last = bucket_tail;
+    }
+
+    *tail = last;
+    return result;
+}
+
+int List_radix_sort(List * list, List_key key)
+{
+    ListNode *tail = NULL;
+    uint64_t first_key = 0;
+    uint64_t differs = 0;
+    int shift = 56;
+
+    if (List_count(list) <= 1) {
+        return 0;
+    }
 
+    // leading bytes that are the same in every key don't need a pass
+    first_key = key(list->first->value);
     LIST_FOREACH(list, first, next, cur) {
-        if (middle > 0) {
-            List_push(left, cur->value);
+        differs |= key(cur->value) ^ first_key;
+    }
+
+    while (shift > 0 && ((differs >> shift) & 0xff) == 0) {
+        shift -= 8;
+    }
+
+    List_relink(list, ListNode_radix_u64(list->first, List_count(list),
+                key, shift, &tail));
+
+    return 0;
+}
+
+// same, comparing the strings from depth on
+static ListNode *ListNode_insertion_str(ListNode * head, List_str_key key,
+        size_t depth, ListNode ** tail)
+{
+    ListNode *sorted = NULL;
+    ListNode *last = NULL;
+
+    while (head != NULL) {
+        ListNode *node = head;
+        head = head->next;
+        node->next = NULL;
+
+        const char *k = key(node->value) + depth;
+
+        if (last == NULL || strcmp(key(last->value) + depth, k) <= 0) {
+            if (last == NULL) {
+                sorted = node;
+            } else {
+                last->next = node;
+            }
+            last = node;
+        } else if (strcmp(key(sorted->value) + depth, k) > 0) {
+            node->next = sorted;
+            sorted = node;
         } else {
-            List_push(right,cur->value);
+            ListNode *cur = sorted;
+            while (strcmp(key(cur->next->value) + depth, k) <= 0) {
+                cur = cur->next;
+            }
+            node->next = cur->next;
+            cur->next = node;
+        }
+    }
+
+    *tail = last;
+    return sorted;
+}
+
+static ListNode *ListNode_radix_str(ListNode * head, int len,
+        List_str_key key, size_t depth, ListNode ** tail)
+{
+    ListNode *heads[LIST_RADIX_BUCKETS];
+    ListNode *tails[LIST_RADIX_BUCKETS];
+    int counts[LIST_RADIX_BUCKETS];
+    ListNode *result = NULL;
+    ListNode *last = NULL;
+    int i = 0;
+
+    while (len > LIST_RADIX_CUTOFF) {
+        memset(tails, 0, sizeof(tails));
+        memset(counts, 0, sizeof(counts));
+
+        while (head != NULL) {
+            int b = (unsigned char)key(head->value)[depth];
+
+            if (tails[b] == NULL) {
+                heads[b] = head;
+            } else {
+                tails[b]->next = head;
+            }
+
+            tails[b] = head;
+            counts[b]++;
+            head = head->next;
         }
 
-        middle--;
+        // everything shares this byte, just look at the next one
+        for (i = 1; i < LIST_RADIX_BUCKETS && counts[i] != len; i++) {
+        }
+
+        if (i == LIST_RADIX_BUCKETS) {
+            break;
+        }
+
+        tails[i]->next = NULL;
+        head = heads[i];
+        depth++;
     }
 
-    List *sort_left = List_merge_sort(left, cmp);
-    List *sort_right = List_merge_sort(right, cmp);
+    if (len <= LIST_RADIX_CUTOFF) {
+        return ListNode_insertion_str(head, key, depth, tail);
+    }
+
+    for (i = 0; i < LIST_RADIX_BUCKETS; i++) {
+        if (tails[i] == NULL) {
+            continue;
+        }
+
+        ListNode *bucket = heads[i];
+        ListNode *bucket_tail = tails[i];
+        bucket_tail->next = NULL;
 
-    if (sort_left != left)
-        List_destroy(left);
-    if (sort_right != right) 
-        List_destroy(right);
+        // bucket 0 holds the strings that ended here, they're all equal
+        if (i > 0 && counts[i] > 1) {
+            bucket = ListNode_radix_str(bucket, counts[i], key, depth + 1,
+                    &bucket_tail);
+        }
 
-    result = list_merge(sort_left, sort_right, cmp);
+        if (last == NULL) {
+            result = bucket;
+        } else {
+            last->next = bucket;
+        }
 
-    List_destroy(sort_left);
-    List_destroy(sort_right);
+        last = bucket_tail;
+    }
 
+    *tail = last;
     return result;
-}
\ No newline at end of file
+}
+
+int List_radix_sort_str(List * list, List_str_key key)
+{
+    ListNode *tail = NULL;
+
+    if (List_count(list) <= 1) {
+        return 0;
+    }
+
+    List_relink(list, ListNode_radix_str(list->first, List_count(list),
+                key, 0, &tail));
+
+    return 0;
+}
+
+typedef struct ListSortTask {
+    ListNode *head;
+    ListNode *right;
+    List_compare cmp;
+} ListSortTask;
+
+static void *ListSortTask_sort(void *arg)
+{
+    ListSortTask *task = arg;
+    task->head = ListNode_sort(task->head, task->cmp);
+    return NULL;
+}
+
+static void *ListSortTask_merge(void *arg)
+{
+    ListSortTask *task = arg;
+    task->head = ListNode_merge(task->head, task->right, task->cmp);
+    return NULL;
+}
+
+/*
+ * Runs fn on every task, the last one on the calling thread. If a thread
+ * can't be started its task just runs here instead.
+ */
+static void ListSortTask_run_all(ListSortTask * tasks, int ntasks,
+        void *(*fn) (void *))
+{
+    pthread_t threads[LIST_PARALLEL_MAX_THREADS];
+    int started[LIST_PARALLEL_MAX_THREADS] = { 0 };
+    int i = 0;
+
+    for (i = 0; i < ntasks - 1; i++) {
+        started[i] = pthread_create(&threads[i], NULL, fn, &tasks[i]) == 0;
+        if (!started[i]) {
+            log_warn("Failed to start sort thread, sorting inline.");
+            fn(&tasks[i]);
+        }
+    }
+
+    fn(&tasks[ntasks - 1]);
+
+    for (i = 0; i < ntasks - 1; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+int List_parallel_sort(List * list, List_compare cmp, int nthreads)
+{
+    ListSortTask tasks[LIST_PARALLEL_MAX_THREADS];
+    ListNode *cur = list->first;
+    int count = List_count(list);
+    int i = 0;
+    int j = 0;
+
+    check(nthreads > 0, "Invalid nthreads %d, must be > 0.", nthreads);
+
+    if (nthreads > LIST_PARALLEL_MAX_THREADS) {
+        nthreads = LIST_PARALLEL_MAX_THREADS;
+    }
+
+    if (nthreads > count) {
+        nthreads = count;
+    }
+
+    if (nthreads <= 1 || count < List_parallel_threshold) {
+        List_merge_sort(list, cmp);
+        return 0;
+    }
+
+    // cut the chain into nthreads segments of nearly equal length
+    for (i = 0; i < nthreads; i++) {
+        int len = count / nthreads + (i < count % nthreads);
+
+        tasks[i].head = cur;
+        tasks[i].cmp = cmp;
+
+        for (j = 0; j < len - 1; j++) {
+            cur = cur->next;
+        }
+
+        ListNode *next = cur->next;
+        cur->next = NULL;
+        cur = next;
+    }
+
+    ListSortTask_run_all(tasks, nthreads, ListSortTask_sort);
+
+    // merge neighbours pairwise, left before right keeps it stable
+    int nsegs = nthreads;
+    while (nsegs > 1) {
+        int npairs = nsegs / 2;
+
+        for (i = 0; i < npairs; i++) {
+            ListNode *left = tasks[2 * i].head;
+            ListNode *right = tasks[2 * i + 1].head;
+            tasks[i].head = left;
+            tasks[i].right = right;
+        }
+
+        ListSortTask_run_all(tasks, npairs, ListSortTask_merge);
+
+        if (nsegs % 2 == 1) {
+            tasks[npairs].head = tasks[nsegs - 1].head;
+            npairs++;
+        }
+
+        nsegs = npairs;
+    }
+
+    List_relink(list, tasks[0].head);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+// min-heap on values, the smallest of the k kept so far sits at 0
+static void List_heap_sift_down(void **heap, int i, int n, List_compare cmp)
+{
+    void *value = heap[i];
+
+    while (2 * i + 1 < n) {
+        int child = 2 * i + 1;
+
+        if (child + 1 < n && cmp(heap[child + 1], heap[child]) < 0) {
+            child++;
+        }
+
+        if (cmp(heap[child], value) >= 0) {
+            break;
+        }
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = value;
+}
+
+static void List_heap_sift_up(void **heap, int i, List_compare cmp)
+{
+    void *value = heap[i];
+
+    while (i > 0 && cmp(value, heap[(i - 1) / 2]) < 0) {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+
+    heap[i] = value;
+}
+
+DArray *List_top_k(List * list, int k, List_compare cmp)
+{
+    DArray *top = NULL;
+    void **heap = NULL;
+    int n = 0;
+
+    check(k > 0, "Invalid k %d, must be > 0.", k);
+
+    if (k > List_count(list)) {
+        k = List_count(list) > 0 ? List_count(list) : 1;
+    }
+
+    top = DArray_create(sizeof(void *), k);
+    check(top != NULL, "Failed to create darray.");
+    heap = top->contents;
+
+    LIST_FOREACH(list, first, next, cur) {
+        if (n < k) {
+            heap[n] = cur->value;
+            List_heap_sift_up(heap, n++, cmp);
+        } else if (cmp(cur->value, heap[0]) > 0) {
+            heap[0] = cur->value;
+            List_heap_sift_down(heap, 0, k, cmp);
+        }
+    }
+
+    // taking the min off the end each time leaves them largest first
+    for (top->end = n; n > 1; n--) {
+        void *min = heap[0];
+        heap[0] = heap[n - 1];
+        heap[n - 1] = min;
+        List_heap_sift_down(heap, 0, n - 1, cmp);
+    }
+
+    return top;
+
+error:
+    return NULL;
+}
+
+// these two keep prev links right as they go, so nothing needs a relink
+static inline void ListRun_append(ListRun * run, ListNode * node)
+{
+    if (run->head == NULL) {
+        run->head = node;
+    } else {
+        run->tail->next = node;
+    }
+
+    node->prev = run->tail;
+    run->tail = node;
+    run->len++;
+}
+
+static inline ListRun ListRun_concat(ListRun a, ListRun b)
+{
+    if (a.head == NULL) return b;
+    if (b.head == NULL) return a;
+
+    a.tail->next = b.head;
+    b.head->prev = a.tail;
+    a.tail = b.tail;
+    a.len += b.len;
+    return a;
+}
+
+static inline unsigned int List_rand(unsigned int *seed)
+{
+    unsigned int x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *seed = x;
+}
+
+// keeps samples a uniform pick of up to LIST_SELECT_SAMPLES of seen values
+static inline void List_reservoir(void **samples, int seen, void *value,
+        unsigned int *seed)
+{
+    unsigned int at = seen < LIST_SELECT_SAMPLES ? (unsigned int)seen :
+        List_rand(seed) % (unsigned int)(seen + 1);
+
+    if (at < LIST_SELECT_SAMPLES) {
+        samples[at] = value;
+    }
+}
+
+/*
+ * Picks a pivot from a random sample of the chain that holds index n.
+ * It aims one sample past n, away from the nearer end, so n most
+ * likely lands in the smaller chain and the next pass is short.
+ */
+static void *List_select_pivot(void **samples, int nsamples, int n, int len,
+        List_compare cmp)
+{
+    int i = 0;
+    int j = 0;
+    int at = (int)((int64_t)n * nsamples / len);
+
+    for (i = 1; i < nsamples; i++) {
+        void *value = samples[i];
+        for (j = i; j > 0 && cmp(samples[j - 1], value) > 0; j--) {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = value;
+    }
+
+    at = n < len / 2 ? at + 1 : at - 1;
+    at = at < 0 ? 0 : at >= nsamples ? nsamples - 1 : at;
+
+    return samples[at];
+}
+
+/*
+ * Quickselect on the node chain: each pass splits the part that holds
+ * index n into less, equal and greater chains around a pivot, keeps the
+ * pieces it's done with, and goes on in the one that still holds n. The
+ * splits keep node order, so nothing moves that doesn't have to.
+ *
+ * Walking a list is all cache misses, so passes are what this counts.
+ * Each split also keeps a reservoir sample of every chain it makes, and
+ * the next pivot comes from that sample without another walk. The
+ * first sample comes from the front of the list only.
+ */
+void *List_nth_element(List * list, int n, List_compare cmp)
+{
+    void *samples[3][LIST_SELECT_SAMPLES];
+    void *current[LIST_SELECT_SAMPLES];
+    ListRun before = { NULL, NULL, 0 };
+    ListRun after = { NULL, NULL, 0 };
+    ListRun rest = { list->first, list->last, List_count(list) };
+    ListNode *node = NULL;
+    unsigned int seed = 2463534242u;
+    void *pivot = NULL;
+    int nsamples = 0;
+
+    check(n >= 0 && n < List_count(list), "Invalid n %d for a list of %d.",
+            n, List_count(list));
+
+    list->last->next = NULL;
+
+    for (node = rest.head; node != NULL && nsamples < 64 * LIST_SELECT_SAMPLES;
+            node = node->next, nsamples++) {
+        List_reservoir(current, nsamples, node->value, &seed);
+    }
+    nsamples = nsamples < LIST_SELECT_SAMPLES ? nsamples : LIST_SELECT_SAMPLES;
+
+    while (rest.len > LIST_SELECT_CUTOFF) {
+        ListRun chains[3] = { { NULL, NULL, 0 } };
+        int c = 0;
+
+        pivot = List_select_pivot(current, nsamples, n, rest.len, cmp);
+
+        for (node = rest.head; node != NULL;) {
+            ListNode *next = node->next;
+            int rc = cmp(node->value, pivot);
+
+            c = rc < 0 ? 0 : rc > 0 ? 2 : 1;
+            node->next = NULL;
+            ListRun_append(&chains[c], node);
+
+            List_reservoir(samples[c], chains[c].len - 1, node->value, &seed);
+            node = next;
+        }
+
+        if (n < chains[0].len) {
+            c = 0;
+            after = ListRun_concat(ListRun_concat(chains[1], chains[2]), after);
+        } else if (n < chains[0].len + chains[1].len) {
+            // n landed on the pivot's value, and that's the answer
+            before = ListRun_concat(before, chains[0]);
+            after = ListRun_concat(chains[2], after);
+            rest = ListRun_concat(ListRun_concat(before, chains[1]), after);
+            goto done;
+        } else {
+            c = 2;
+            before = ListRun_concat(ListRun_concat(before, chains[0]), chains[1]);
+            n -= chains[0].len + chains[1].len;
+        }
+
+        rest = chains[c];
+        nsamples = rest.len < LIST_SELECT_SAMPLES ? rest.len : LIST_SELECT_SAMPLES;
+        memcpy(current, samples[c], nsamples * sizeof(void *));
+    }
+
+    // short enough now to just sort what's left
+    rest.head = ListNode_sort(rest.head, cmp);
+    rest.head->prev = NULL;
+    for (rest.tail = rest.head; rest.tail->next != NULL;
+            rest.tail = rest.tail->next) {
+        rest.tail->next->prev = rest.tail;
+    }
+
+    for (node = rest.head; n > 0; n--) {
+        node = node->next;
+    }
+    pivot = node->value;
+    rest = ListRun_concat(ListRun_concat(before, rest), after);
+
+done:
+    list->first = rest.head;
+    list->first->prev = NULL;
+    list->last = rest.tail;
+
+    return pivot;
+
+error:
+    return NULL;
+}
+
+// source a's head goes out before source b's, an empty source never does
+static inline int ListMerge_beats(ListMerge * merge, int a, int b)
+{
+    ListNode *x = merge->heads[a];
+    ListNode *y = merge->heads[b];
+    int rc = 0;
+
+    if (x == NULL || y == NULL) {
+        return y == NULL && x != NULL;
+    }
+
+    rc = merge->cmp(x->value, y->value);
+    return rc < 0 || (rc == 0 && a < b);
+}
+
+/*
+ * Loser tree: tree[i] holds the source that lost the match at internal
+ * node i and tree[0] the overall winner, the leaves are the sources at
+ * nlists..2*nlists-1. Taking the winner's head only replays the matches
+ * on its path to the root, so each node costs log2(nlists) compares.
+ */
+ListMerge *ListMerge_create(List ** lists, int nlists, List_compare cmp)
+{
+    ListMerge *merge = NULL;
+    int *winners = NULL;
+    int i = 0;
+
+    check(nlists > 0, "Invalid nlists %d, must be > 0.", nlists);
+
+    merge = calloc(1, sizeof(ListMerge));
+    check_mem(merge);
+
+    merge->cmp = cmp;
+    merge->nlists = nlists;
+    merge->heads = malloc(nlists * sizeof(ListNode *));
+    check_mem(merge->heads);
+    merge->tree = malloc(nlists * sizeof(int));
+    check_mem(merge->tree);
+    winners = malloc(2 * nlists * sizeof(int));
+    check_mem(winners);
+
+    for (i = 0; i < nlists; i++) {
+        merge->heads[i] = lists[i]->first;
+        winners[nlists + i] = i;
+    }
+
+    for (i = nlists - 1; i > 0; i--) {
+        int a = winners[2 * i];
+        int b = winners[2 * i + 1];
+
+        if (ListMerge_beats(merge, a, b)) {
+            winners[i] = a;
+            merge->tree[i] = b;
+        } else {
+            winners[i] = b;
+            merge->tree[i] = a;
+        }
+    }
+
+    merge->tree[0] = nlists > 1 ? winners[1] : 0;
+
+    free(winners);
+    return merge;
+
+error:
+    free(winners);
+    ListMerge_destroy(merge);
+    return NULL;
+}
+
+ListNode *ListMerge_next(ListMerge * merge)
+{
+    int winner = merge->tree[0];
+    ListNode *node = merge->heads[winner];
+    int i = 0;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    merge->heads[winner] = node->next;
+
+    for (i = (winner + merge->nlists) / 2; i > 0; i /= 2) {
+        if (ListMerge_beats(merge, merge->tree[i], winner)) {
+            int loser = winner;
+            winner = merge->tree[i];
+            merge->tree[i] = loser;
+        }
+    }
+
+    merge->tree[0] = winner;
+    return node;
+}
+
+void ListMerge_destroy(ListMerge * merge)
+{
+    if (merge) {
+        free(merge->heads);
+        free(merge->tree);
+        free(merge);
+    }
+}
+
+List *List_merge_many(List ** lists, int nlists, List_compare cmp)
+{
+    List *result = NULL;
+    ListMerge *merge = NULL;
+    ListNode *node = NULL;
+    int i = 0;
+
+    check(nlists > 0, "Invalid nlists %d, must be > 0.", nlists);
+
+    for (i = 1; i < nlists; i++) {
+        check(lists[i]->pool == lists[0]->pool,
+                "List %d doesn't share nodes with list 0, they can't move.", i);
+    }
+
+    merge = ListMerge_create(lists, nlists, cmp);
+    check(merge != NULL, "Failed to start the merge.");
+    result = List_create_sharing(lists[0]);
+    check_mem(result);
+
+    // next has already stepped past node, so relinking it is safe
+    while ((node = ListMerge_next(merge)) != NULL) {
+        node->prev = result->last;
+        node->next = NULL;
+
+        if (result->last == NULL) {
+            result->first = node;
+        } else {
+            result->last->next = node;
+        }
+
+        result->last = node;
+        result->count++;
+    }
+
+    for (i = 0; i < nlists; i++) {
+        lists[i]->first = lists[i]->last = NULL;
+        lists[i]->count = 0;
+    }
+
+    ListMerge_destroy(merge);
+    return result;
+
+error:
+    ListMerge_destroy(merge);
+    return NULL;
+}
+
+typedef struct ListCached {
+    uint64_t key;
+    const char *str;
+    ListNode *node;
+} ListCached;
+
+// stable bottom up merge sort of the cached keys, tmp is as big as items
+static void ListCached_sort(ListCached * items, ListCached * tmp, int n)
+{
+    ListCached *from = items;
+    ListCached *to = tmp;
+    int width = 0;
+    int i = 0;
+
+    // short runs first, insertion sort is cheaper than merging them
+    for (i = 0; i < n; i += LIST_RADIX_CUTOFF) {
+        int end = i + LIST_RADIX_CUTOFF < n ? i + LIST_RADIX_CUTOFF : n;
+        int j = 0;
+
+        for (j = i + 1; j < end; j++) {
+            ListCached item = items[j];
+            int k = j;
+
+            for (; k > i && items[k - 1].key > item.key; k--) {
+                items[k] = items[k - 1];
+            }
+            items[k] = item;
+        }
+    }
+
+    for (width = LIST_RADIX_CUTOFF; width < n; width *= 2) {
+        for (i = 0; i < n; i += 2 * width) {
+            int mid = i + width < n ? i + width : n;
+            int end = i + 2 * width < n ? i + 2 * width : n;
+            int a = i;
+            int b = mid;
+            int out = i;
+
+            while (a < mid && b < end) {
+                to[out++] = from[b].key < from[a].key ? from[b++] : from[a++];
+            }
+            while (a < mid) to[out++] = from[a++];
+            while (b < end) to[out++] = from[b++];
+        }
+
+        ListCached *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != items) {
+        memcpy(items, from, n * sizeof(ListCached));
+    }
+}
+
+// rebuilds the list in the order of items
+static void ListCached_relink(List * list, ListCached * items, int n)
+{
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        items[i].node->prev = i > 0 ? items[i - 1].node : NULL;
+        items[i].node->next = i + 1 < n ? items[i + 1].node : NULL;
+    }
+
+    list->first = items[0].node;
+    list->last = items[n - 1].node;
+}
+
+static ListCached *ListCached_create(List * list, ListCached ** tmp)
+{
+    ListCached *items = malloc(List_count(list) * sizeof(ListCached));
+    check_mem(items);
+    *tmp = malloc(List_count(list) * sizeof(ListCached));
+    check_mem(*tmp);
+
+    return items;
+
+error:
+    free(items);
+    return NULL;
+}
+
+int List_cached_sort(List * list, List_key key, List_compare cmp)
+{
+    ListCached *items = NULL;
+    ListCached *tmp = NULL;
+    int n = List_count(list);
+    int i = 0;
+    int j = 0;
+
+    if (n <= 1) {
+        return 0;
+    }
+
+    items = ListCached_create(list, &tmp);
+    check(items != NULL, "Failed to make the key cache.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        items[i].key = key(cur->value);
+        items[i].node = cur;
+        i++;
+    }
+
+    ListCached_sort(items, tmp, n);
+
+    // only the values with the same key need the real compare
+    for (i = 0; i < n; i = j) {
+        for (j = i + 1; j < n && items[j].key == items[i].key; j++) {
+        }
+
+        if (j - i > 1) {
+            ListNode *head = NULL;
+            ListNode *node = NULL;
+            int k = 0;
+
+            for (k = j - 1; k >= i; k--) {
+                items[k].node->next = head;
+                head = items[k].node;
+            }
+
+            for (node = ListNode_sort(head, cmp), k = i; k < j;
+                    node = node->next, k++) {
+                items[k].node = node;
+            }
+        }
+    }
+
+    ListCached_relink(list, items, n);
+
+    free(items);
+    free(tmp);
+    return 0;
+
+error:
+    return -1;
+}
+
+// the 8 bytes of str from depth on, big endian and zero past the end
+static inline uint64_t ListCached_str_key(const char *str)
+{
+    uint64_t key = 0;
+    int i = 0;
+
+    for (i = 0; i < 8 && str[i] != '\0'; i++) {
+        key |= (uint64_t)(unsigned char)str[i] << (56 - 8 * i);
+    }
+
+    return key;
+}
+
+static void ListCached_sort_str(ListCached * items, ListCached * tmp, int n,
+        int depth)
+{
+    int i = 0;
+    int j = 0;
+
+    // a prefix they all share, like a common path, needs no sort at all
+    while ((items[0].key & 0xff) != 0) {
+        for (i = 1; i < n && items[i].key == items[0].key; i++) {
+        }
+
+        if (i < n) {
+            break;
+        }
+
+        depth += 8;
+        for (i = 0; i < n; i++) {
+            items[i].key = ListCached_str_key(items[i].str + depth);
+        }
+    }
+
+    ListCached_sort(items, tmp, n);
+
+    for (i = 0; i < n; i = j) {
+        for (j = i + 1; j < n && items[j].key == items[i].key; j++) {
+        }
+
+        // a zero last byte means the strings ended, so they're equal
+        if (j - i > 1 && (items[i].key & 0xff) != 0) {
+            int k = 0;
+
+            for (k = i; k < j; k++) {
+                items[k].key = ListCached_str_key(items[k].str + depth + 8);
+            }
+
+            ListCached_sort_str(items + i, tmp, j - i, depth + 8);
+        }
+    }
+}
+
+int List_cached_sort_str(List * list, List_str_key key)
+{
+    ListCached *items = NULL;
+    ListCached *tmp = NULL;
+    int n = List_count(list);
+    int i = 0;
+
+    if (n <= 1) {
+        return 0;
+    }
+
+    items = ListCached_create(list, &tmp);
+    check(items != NULL, "Failed to make the key cache.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        items[i].str = key(cur->value);
+        items[i].key = ListCached_str_key(items[i].str);
+        items[i].node = cur;
+        i++;
+    }
+
+    ListCached_sort_str(items, tmp, n, 0);
+    ListCached_relink(list, items, n);
+
+    free(items);
+    free(tmp);
+    return 0;
+
+error:
+    return -1;
+}
+
+/*
+ * The node being visited is LIST_PREFETCH_AHEAD behind the walk, kept in
+ * a ring of the nodes in between. The walk still has to load each node
+ * to find the next one, but the values, which are what miss worst, were
+ * asked for AHEAD nodes ago by the time fn needs them.
+ */
+static void List_prefetch_walk(List * list, List_visit_fn visit,
+        List_map_fn map, void *ctx)
+{
+    ListNode *ring[LIST_PREFETCH_AHEAD];
+    ListNode *node = NULL;
+    ListNode *ahead = list->first;
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; ahead != NULL; ahead = ahead->next, i++) {
+        LIST_PREFETCH(ahead->next);
+        LIST_PREFETCH(ahead->value);
+
+        if (i >= LIST_PREFETCH_AHEAD) {
+            node = ring[i % LIST_PREFETCH_AHEAD];
+            if (map) {
+                node->value = map(node->value, ctx);
+            } else {
+                visit(node->value, ctx);
+            }
+        }
+
+        ring[i % LIST_PREFETCH_AHEAD] = ahead;
+    }
+
+    // the last few the walk got to before it ran out
+    for (j = i > LIST_PREFETCH_AHEAD ? i - LIST_PREFETCH_AHEAD : 0; j < i; j++) {
+        node = ring[j % LIST_PREFETCH_AHEAD];
+        if (map) {
+            node->value = map(node->value, ctx);
+        } else {
+            visit(node->value, ctx);
+        }
+    }
+}
+
+void List_foreach_batch(List * list, List_visit_fn fn, void *ctx)
+{
+    List_prefetch_walk(list, fn, NULL, ctx);
+}
+
+void List_map(List * list, List_map_fn fn, void *ctx)
+{
+    List_prefetch_walk(list, NULL, fn, ctx);
+}
+
+void List_foreach_chunked(List * list, List_chunk_fn fn, void *ctx)
+{
+    ListNode *chunk[LIST_PREFETCH_CHUNK];
+    ListNode *node = list->first;
+    int n = 0;
+
+    while (node != NULL) {
+        for (n = 0; node != NULL && n < LIST_PREFETCH_CHUNK; node = node->next) {
+            LIST_PREFETCH(node->next);
+            LIST_PREFETCH(node->value);
+            chunk[n++] = node;
+        }
+
+        fn(chunk, n, ctx);
+    }
+}
+
+int List_split(List * list, int k, ListNode ** starts, int *counts)
+{
+    int n = List_count(list);
+    int mid = 0;
+    int i = 0;
+    int j = 0;
+
+    check(k > 0, "Can't split into %d runs.", k);
+
+    if (k > n) {
+        k = n;
+    }
+
+    // the first n % k runs get one extra
+    for (i = 0; i < k; i++) {
+        counts[i] = n / k + (i < n % k);
+    }
+
+    if (k == 0) {
+        return 0;
+    }
+
+    // the front half of the starts walking forward, the back half backward
+    mid = (k + 1) / 2;
+
+    starts[0] = list->first;
+    for (i = 1; i < mid; i++) {
+        starts[i] = starts[i - 1];
+        for (j = 0; j < counts[i - 1]; j++) {
+            starts[i] = starts[i]->next;
+        }
+    }
+
+    for (i = k - 1; i >= mid; i--) {
+        starts[i] = i == k - 1 ? list->last : starts[i + 1]->prev;
+        for (j = 1; j < counts[i]; j++) {
+            starts[i] = starts[i]->prev;
+        }
+    }
+
+    return k;
+
+error:
+    return -1;
+}
+
+typedef struct ListParallelJob {
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    int remaining;
+} ListParallelJob;
+
+typedef struct ListParallelTask {
+    ListNode *first;
+    int count;
+    List_map_fn map;
+    List_reduce_fn reduce;
+    void *ctx;
+    void *result;
+    ListParallelJob *job;
+} ListParallelTask;
+
+static void ListParallelTask_fold(ListParallelTask * task)
+{
+    ListNode *node = task->first;
+    int i = 0;
+
+    for (i = 0; i < task->count; i++, node = node->next) {
+        if (task->map) {
+            node->value = task->map(node->value, task->ctx);
+        } else {
+            task->result = task->reduce(task->result, node->value, task->ctx);
+        }
+    }
+}
+
+static void ListParallelTask_run(void *arg)
+{
+    ListParallelTask *task = arg;
+    ListParallelJob *job = task->job;
+
+    ListParallelTask_fold(task);
+
+    pthread_mutex_lock(&job->lock);
+    if (--job->remaining == 0) {
+        pthread_cond_signal(&job->done);
+    }
+    pthread_mutex_unlock(&job->lock);
+}
+
+/*
+ * Runs the pool's queued tasks here while the job isn't done, and only
+ * sleeps once there's nothing left to take, which means the job's tasks
+ * are all running somewhere. So a map called from inside a task can't
+ * tie up its own worker waiting.
+ */
+static void ListParallelJob_wait(ThreadPool * pool, ListParallelJob * job)
+{
+    int ran = 0;
+
+    pthread_mutex_lock(&job->lock);
+
+    while (job->remaining > 0) {
+        pthread_mutex_unlock(&job->lock);
+        ran = ThreadPool_run_one(pool);
+        pthread_mutex_lock(&job->lock);
+
+        if (!ran && job->remaining > 0) {
+            pthread_cond_wait(&job->done, &job->lock);
+        }
+    }
+
+    pthread_mutex_unlock(&job->lock);
+}
+
+/*
+ * Splits the list into runs, hands each to the pool as a copy of proto
+ * and waits for all of them. Returns the finished tasks in list order,
+ * or NULL without having touched the list if it couldn't set them up.
+ */
+static ListParallelTask *List_parallel_run(ThreadPool * pool, List * list,
+        ListParallelTask proto, int *ntasks)
+{
+    int k = ThreadPool_threads(pool) * LIST_PARALLEL_SEGMENTS;
+    ListNode **starts = calloc(k, sizeof(ListNode *));
+    int *counts = calloc(k, sizeof(int));
+    ListParallelTask *tasks = calloc(k, sizeof(ListParallelTask));
+    ListParallelJob job = { .remaining = 0 };
+    int i = 0;
+
+    check_mem(starts);
+    check_mem(counts);
+    check_mem(tasks);
+
+    *ntasks = List_split(list, k, starts, counts);
+    check(*ntasks > 0, "Nothing to split.");
+
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.done, NULL);
+    job.remaining = *ntasks;
+
+    for (i = 0; i < *ntasks; i++) {
+        tasks[i] = proto;
+        tasks[i].first = starts[i];
+        tasks[i].count = counts[i];
+        tasks[i].job = &job;
+
+        if (ThreadPool_submit(pool, ListParallelTask_run, &tasks[i]) != 0) {
+            log_warn("Failed to submit run %d, running it inline.", i);
+            ListParallelTask_run(&tasks[i]);
+        }
+    }
+
+    ListParallelJob_wait(pool, &job);
+
+    pthread_cond_destroy(&job.done);
+    pthread_mutex_destroy(&job.lock);
+    free(starts);
+    free(counts);
+    return tasks;
+
+error:
+    free(starts);
+    free(counts);
+    free(tasks);
+    return NULL;
+}
+
+int List_parallel_map(ThreadPool * pool, List * list, List_map_fn fn,
+        void *ctx)
+{
+    ListParallelTask proto = { .map = fn, .ctx = ctx };
+    ListParallelTask *tasks = NULL;
+    int ntasks = 0;
+
+    if (List_count(list) == 0) {
+        return 0;
+    }
+
+    tasks = List_parallel_run(pool, list, proto, &ntasks);
+
+    if (tasks == NULL) {
+        // still gets done, just on this thread
+        proto.first = list->first;
+        proto.count = List_count(list);
+        ListParallelTask_fold(&proto);
+    }
+
+    free(tasks);
+    return 0;
+}
+
+void *List_parallel_reduce(ThreadPool * pool, List * list, void *init,
+        List_reduce_fn reduce, List_reduce_fn combine, void *ctx)
+{
+    ListParallelTask proto = { .reduce = reduce, .ctx = ctx, .result = init };
+    ListParallelTask *tasks = NULL;
+    void *result = init;
+    int ntasks = 0;
+    int i = 0;
+
+    if (List_count(list) == 0) {
+        return init;
+    }
+
+    tasks = List_parallel_run(pool, list, proto, &ntasks);
+
+    if (tasks == NULL) {
+        proto.first = list->first;
+        proto.count = List_count(list);
+        ListParallelTask_fold(&proto);
+        return proto.result;
+    }
+
+    result = tasks[0].result;
+    for (i = 1; i < ntasks; i++) {
+        result = combine(result, tasks[i].result, ctx);
+    }
+
+    free(tasks);
+    return result;
+}
@@ -2,11 +2,128 @@
 #define lcthw_List_algos_h
 
 #include <lcthw/list.h>
+#include <stdint.h>
+
+struct DArray;
+struct ThreadPool;
 
 typedef int (*List_compare) (const void *a, const void *b);
 
+// keys have to sort as unsigned, flip the top bit of signed ones
+typedef uint64_t (*List_key) (const void *value);
+typedef const char *(*List_str_key) (const void *value);
+
+typedef void (*List_visit_fn) (void *value, void *ctx);
+typedef void *(*List_map_fn) (void *value, void *ctx);
+typedef void (*List_chunk_fn) (ListNode ** nodes, int n, void *ctx);
+typedef void *(*List_reduce_fn) (void *acc, void *value, void *ctx);
+
 int List_bubble_sort(List * list, List_compare cmp);
 
+// sorts in place by relinking nodes and returns list, stable
 List *List_merge_sort(List * list, List_compare cmp);
 
+// adaptive, stable, near O(n) on lists that are mostly in order already
+int List_tim_sort(List * list, List_compare cmp);
+
+// stable MSD radix sort on the bytes of 64 bit keys
+int List_radix_sort(List * list, List_key key);
+
+// stable MSD radix sort on the bytes of C string keys
+int List_radix_sort_str(List * list, List_str_key key);
+
+// lists shorter than this are sorted on the calling thread
+extern int List_parallel_threshold;
+
+// stable in-place merge sort of nthreads segments, merged in parallel
+int List_parallel_sort(List * list, List_compare cmp, int nthreads);
+
+// the k largest values, largest first, in a DArray of at most k slots
+struct DArray *List_top_k(List * list, int k, List_compare cmp);
+
+/*
+ * Partially sorts the list so the value at index n is the one a full
+ * sort would put there, nothing before it is greater and nothing after
+ * it is less. Returns that value, O(n) expected.
+ */
+void *List_nth_element(List * list, int n, List_compare cmp);
+
+/*
+ * Decorate, sort, undecorate: key is computed once per value into an
+ * array, the sort runs on those, and cmp is only called on values whose
+ * keys tie. key(a) < key(b) has to mean cmp(a, b) < 0. Stable.
+ */
+int List_cached_sort(List * list, List_key key, List_compare cmp);
+
+// same for C strings, ties on 8 bytes move on to the next 8, no cmp calls
+int List_cached_sort_str(List * list, List_str_key key);
+
+/*
+ * Lazy k-way merge of sorted lists. ListMerge_next hands back the
+ * nodes in merged order, equal values in list order, and NULL once
+ * they're all out. The lists are only read, and can't change while
+ * the merge is going.
+ */
+typedef struct ListMerge {
+    List_compare cmp;
+    int nlists;
+    ListNode **heads;
+    int *tree;
+} ListMerge;
+
+ListMerge *ListMerge_create(List ** lists, int nlists, List_compare cmp);
+ListNode *ListMerge_next(ListMerge * merge);
+void ListMerge_destroy(ListMerge * merge);
+
+/*
+ * Moves every node into one new sorted list, the inputs end up empty.
+ * The lists all have to share nodes, see List_create_sharing.
+ */
+List *List_merge_many(List ** lists, int nlists, List_compare cmp);
+
+// how far the walk runs ahead of fn, and how many nodes a chunk holds
+#define LIST_PREFETCH_AHEAD 8
+#define LIST_PREFETCH_CHUNK 64
+
+/*
+ * LIST_FOREACH with fn called LIST_PREFETCH_AHEAD nodes behind the walk,
+ * which prefetches each node's next and value as it finds them, so the
+ * cache misses overlap instead of queueing up one after the other. The
+ * list can't change while it runs, fn only gets to look.
+ */
+void List_foreach_batch(List * list, List_visit_fn fn, void *ctx);
+
+// the same walk, setting node->value = fn(node->value, ctx)
+void List_map(List * list, List_map_fn fn, void *ctx);
+
+/*
+ * Collects up to LIST_PREFETCH_CHUNK nodes at a time, prefetching their
+ * values on the way, and hands fn the whole chunk, so fn can look at
+ * them in whatever order suits it. fn can change values, not links.
+ */
+void List_foreach_chunked(List * list, List_chunk_fn fn, void *ctx);
+
+/*
+ * Cuts the list into at most k runs whose lengths differ by at most one,
+ * filling in where each starts and how long it is, and returns how many
+ * there are. Each start is found from whichever end of the list is
+ * nearer, so it walks about half the list, not all of it.
+ */
+int List_split(List * list, int k, ListNode ** starts, int *counts);
+
+// runs are dealt out this many per pool thread, so stealing can even them out
+#define LIST_PARALLEL_SEGMENTS 4
+
+// node->value = fn(node->value, ctx) for every node, on the pool's threads
+int List_parallel_map(struct ThreadPool *pool, List * list, List_map_fn fn,
+        void *ctx);
+
+/*
+ * Folds every run from init with reduce, then folds the runs' results
+ * together in list order with combine. init has to be an identity for
+ * combine, and combine associative, for this to match a serial fold.
+ */
+void *List_parallel_reduce(struct ThreadPool *pool, List * list, void *init,
+        List_reduce_fn reduce, List_reduce_fn combine, void *ctx);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include <lcthw/list_external.h>
+#include <lcthw/darray.h>
+#include <lcthw/dbg.h>
+#include <time.h>
+
+#define LIST_EXTERNAL_BUFFER (64 * 1024)
+#define LIST_EXTERNAL_BLOCK 4096
+
+typedef struct ListExternalRun {
+    FILE *file;
+    long count;
+} ListExternalRun;
+
+// what a merge pass writes into when it isn't the last one
+typedef struct ListExternalWriter {
+    ListExternal *ext;
+    ListExternalRun *run;
+} ListExternalWriter;
+
+static double ListExternal_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static ListExternalRun *ListExternalRun_create()
+{
+    ListExternalRun *run = calloc(1, sizeof(ListExternalRun));
+    check_mem(run);
+
+    run->file = tmpfile();
+    check(run->file != NULL, "Failed to make a run file.");
+    setvbuf(run->file, NULL, _IOFBF, LIST_EXTERNAL_BUFFER);
+
+    return run;
+
+error:
+    free(run);
+    return NULL;
+}
+
+static void ListExternalRun_destroy(ListExternalRun * run)
+{
+    if (run) {
+        if (run->file) fclose(run->file);
+        free(run);
+    }
+}
+
+static void ListExternal_destroy_runs(DArray * runs)
+{
+    int i = 0;
+
+    if (runs) {
+        for (i = 0; i < DArray_count(runs); i++) {
+            ListExternalRun_destroy(DArray_get(runs, i));
+        }
+        DArray_destroy(runs);
+    }
+}
+
+// the writes are all buffered, flushing is what can find a full disk
+static int ListExternalRun_finish(ListExternal * ext, ListExternalRun * run)
+{
+    check(fflush(run->file) == 0, "Failed to write a run.");
+    ext->stats.bytes_spilled += ftell(run->file);
+    rewind(run->file);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static int ListExternal_write_value(void *value, void *ctx)
+{
+    ListExternalWriter *writer = ctx;
+
+    check(writer->ext->write(value, writer->run->file) == 0,
+            "Failed to write a value.");
+    writer->run->count++;
+
+    if (writer->ext->free_value) {
+        writer->ext->free_value(value);
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+// sorts what's in memory and writes it out as one more run
+static int ListExternal_spill(ListExternal * ext, List * values, DArray * runs)
+{
+    ListExternalRun *run = ListExternalRun_create();
+    ListExternalWriter writer = { ext, run };
+    check(run != NULL, "Failed to start a run.");
+
+    List_merge_sort(values, ext->cmp);
+
+    // shift only once it's written, so on error the caller still owns it
+    while (List_count(values) > 0) {
+        check(ListExternal_write_value(List_first(values), &writer) == 0,
+                "Failed to spill run %d.", DArray_count(runs));
+        List_shift(values);
+    }
+
+    check(ListExternalRun_finish(ext, run) == 0, "Failed to spill a run.");
+    check(DArray_push(runs, run) == 0, "Failed to keep the run.");
+    ext->stats.runs++;
+
+    return 0;
+
+error:
+    ListExternalRun_destroy(run);
+    return -1;
+}
+
+static inline int ListExternal_less(ListExternal * ext, void **heads,
+        int a, int b)
+{
+    int rc = ext->cmp(heads[a], heads[b]);
+    // runs are in input order, so a tie goes to the earlier one
+    return rc < 0 || (rc == 0 && a < b);
+}
+
+static void ListExternal_sift_down(ListExternal * ext, void **heads,
+        int *heap, int i, int n)
+{
+    int top = heap[i];
+
+    while (2 * i + 1 < n) {
+        int child = 2 * i + 1;
+
+        if (child + 1 < n &&
+                ListExternal_less(ext, heads, heap[child + 1], heap[child])) {
+            child++;
+        }
+
+        if (!ListExternal_less(ext, heads, heap[child], top)) {
+            break;
+        }
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    heap[i] = top;
+}
+
+/*
+ * Streams nruns sorted runs into sink through a min-heap of their
+ * current heads. The runs are closed and freed either way.
+ */
+static int ListExternal_merge(ListExternal * ext, ListExternalRun ** runs,
+        int nruns, List_sink sink, void *sink_ctx)
+{
+    void **heads = calloc(nruns, sizeof(void *));
+    int *heap = calloc(nruns, sizeof(int));
+    int n = 0;
+    int i = 0;
+    int rc = -1;
+
+    check_mem(heads);
+    check_mem(heap);
+
+    for (i = 0; i < nruns; i++) {
+        heads[i] = ext->read(runs[i]->file);
+        check(heads[i] != NULL, "Failed to read run %d.", i);
+        runs[i]->count--;
+        heap[n++] = i;
+    }
+
+    for (i = n / 2 - 1; i >= 0; i--) {
+        ListExternal_sift_down(ext, heads, heap, i, n);
+    }
+
+    while (n > 0) {
+        int top = heap[0];
+        void *value = heads[top];
+
+        // the sink owns the value even when it fails
+        heads[top] = NULL;
+        check(sink(value, sink_ctx) == 0, "Sink refused a value.");
+
+        if (runs[top]->count > 0) {
+            heads[top] = ext->read(runs[top]->file);
+            check(heads[top] != NULL, "Failed to read run %d.", top);
+            runs[top]->count--;
+        } else {
+            heap[0] = heap[--n];
+        }
+
+        ListExternal_sift_down(ext, heads, heap, 0, n);
+    }
+
+    rc = 0;
+
+error:          // fallthrough
+    for (i = 0; i < nruns; i++) {
+        // whatever the sink didn't take is still ours to free
+        if (heads && heads[i] && ext->free_value) {
+            ext->free_value(heads[i]);
+        }
+        ListExternalRun_destroy(runs[i]);
+        runs[i] = NULL;
+    }
+
+    free(heads);
+    free(heap);
+    return rc;
+}
+
+/*
+ * Merges groups of fan_in runs into longer runs until there are few
+ * enough left for the last pass to take in one go.
+ */
+static DArray *ListExternal_reduce(ListExternal * ext, DArray * runs,
+        int fan_in)
+{
+    DArray *next = NULL;
+    int i = 0;
+
+    while (DArray_count(runs) > fan_in) {
+        next = DArray_create(sizeof(ListExternalRun), DArray_count(runs) /
+                fan_in + 1);
+        check(next != NULL, "Failed to make a merge pass.");
+
+        for (i = 0; i < DArray_count(runs); i += fan_in) {
+            int n = DArray_count(runs) - i < fan_in ?
+                DArray_count(runs) - i : fan_in;
+            ListExternalWriter writer = { ext, ListExternalRun_create() };
+
+            check(writer.run != NULL, "Failed to start a merged run.");
+            check(DArray_push(next, writer.run) == 0, "Failed to keep a run.");
+            check(ListExternal_merge(ext, (ListExternalRun **)runs->contents +
+                        i, n, ListExternal_write_value, &writer) == 0,
+                    "Failed to merge runs %d to %d.", i, i + n);
+            check(ListExternalRun_finish(ext, writer.run) == 0,
+                    "Failed to finish a merged run.");
+        }
+
+        ext->stats.passes++;
+        ListExternal_destroy_runs(runs);
+        runs = next;
+        next = NULL;
+    }
+
+    return runs;
+
+error:
+    ListExternal_destroy_runs(next);
+    ListExternal_destroy_runs(runs);
+    return NULL;
+}
+
+int List_external_sort(ListExternal * ext, List_source source,
+        void *source_ctx, List_sink sink, void *sink_ctx)
+{
+    int fan_in = ext->fan_in > 1 ? ext->fan_in : LIST_EXTERNAL_FAN_IN;
+    List *values = List_create_pooled(LIST_EXTERNAL_BLOCK);
+    DArray *runs = DArray_create(sizeof(ListExternalRun), 16);
+    size_t used = 0;
+    void *value = NULL;
+    int rc = -1;
+
+    check(values != NULL && runs != NULL, "Failed to start the sort.");
+    check(ext->mem_cap > 0, "mem_cap has to be > 0.");
+
+    memset(&ext->stats, 0, sizeof(ext->stats));
+    double start = ListExternal_now();
+
+    while ((value = source(source_ctx)) != NULL) {
+        List_push(values, value);
+        used += sizeof(ListNode) + (ext->size ? ext->size(value) : 0);
+
+        if (used >= ext->mem_cap) {
+            check(ListExternal_spill(ext, values, runs) == 0,
+                    "Failed to spill a run.");
+            used = 0;
+        }
+    }
+
+    if (DArray_count(runs) == 0) {
+        // it all fit, so this is just a sort
+        List_merge_sort(values, ext->cmp);
+        ext->stats.run_secs = ListExternal_now() - start;
+
+        while (List_count(values) > 0) {
+            check(sink(List_shift(values), sink_ctx) == 0,
+                    "Sink refused a value.");
+        }
+
+        rc = 0;
+    } else {
+        if (List_count(values) > 0) {
+            check(ListExternal_spill(ext, values, runs) == 0,
+                    "Failed to spill the last run.");
+        }
+
+        ext->stats.run_secs = ListExternal_now() - start;
+        start = ListExternal_now();
+
+        runs = ListExternal_reduce(ext, runs, fan_in);
+        check(runs != NULL, "Failed to merge the runs down.");
+
+        ext->stats.passes++;
+        rc = ListExternal_merge(ext, (ListExternalRun **)runs->contents,
+                DArray_count(runs), sink, sink_ctx);
+        ext->stats.merge_secs = ListExternal_now() - start;
+    }
+
+error:          // fallthrough
+    ListExternal_destroy_runs(runs);
+    if (values) {
+        while (ext->free_value && List_count(values) > 0) {
+            ext->free_value(List_shift(values));
+        }
+        List_destroy(values);
+    }
+    return rc;
+}
+
+void *List_external_shift(void *list)
+{
+    return List_shift(list);
+}
+
+int List_external_push(void *value, void *list)
+{
+    List_push(list, value);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef lcthw_List_external_h
+#define lcthw_List_external_h
+
+#include <stdio.h>
+#include <lcthw/list_algos.h>
+
+/*
+ * External merge sort. Values are pulled from a source and sorted in
+ * runs of up to mem_cap bytes. Each full run is written to a tmpfile
+ * with write, and the runs are then merged back with read, fan_in at
+ * a time, into a sink:
+ *
+ *     ListExternal ext = { .cmp = cmp_rec, .write = write_rec,
+ *         .read = read_rec, .size = size_rec, .free_value = free,
+ *         .mem_cap = 64 * 1024 * 1024 };
+ *     List_external_sort(&ext, List_external_shift, in,
+ *             List_external_push, out);
+ *
+ * Values can't be NULL. read returns a new value, and the sink owns
+ * every value it's given. If everything fits under mem_cap in one run,
+ * nothing touches the disk. Each run file open during a merge also
+ * costs a stdio buffer, about fan_in * 64K on top of mem_cap.
+ */
+
+typedef int (*List_serialize) (const void *value, FILE * out);
+typedef void *(*List_deserialize) (FILE * in);
+typedef size_t (*List_value_size) (const void *value);
+
+// next value, or NULL once there are no more
+typedef void *(*List_source) (void *ctx);
+typedef int (*List_sink) (void *value, void *ctx);
+
+typedef struct ListExternalStats {
+    int runs;
+    int passes;
+    long bytes_spilled;
+    double run_secs;
+    double merge_secs;
+} ListExternalStats;
+
+typedef struct ListExternal {
+    List_compare cmp;
+    List_serialize write;
+    List_deserialize read;
+    // bytes a value holds on top of its ListNode, NULL counts just the node
+    List_value_size size;
+    // called on each value once it's on disk, NULL leaves it alone
+    void (*free_value) (void *value);
+    size_t mem_cap;
+    // most runs merged at once, 0 means LIST_EXTERNAL_FAN_IN
+    int fan_in;
+    ListExternalStats stats;
+} ListExternal;
+
+#define LIST_EXTERNAL_FAN_IN 16
+
+int List_external_sort(ListExternal * ext, List_source source,
+        void *source_ctx, List_sink sink, void *sink_ctx);
+
+// source and sink for Lists, ctx is the List
+void *List_external_shift(void *list);
+int List_external_push(void *value, void *list);
+
+#endif
@@ -0,0 +1,271 @@
+#include <lcthw/list_snapshot.h>
+#include <lcthw/dbg.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LIST_SNAPSHOT_BUFFER (1024 * 1024)
+#define LIST_SNAPSHOT_BATCH 4096
+#define FNV64_OFFSET 14695981039346656037ULL
+#define FNV64_PRIME 1099511628211ULL
+
+#define LIST_SNAPSHOT_PAD(N) (((N) + 7) & ~(uint64_t)7)
+
+static uint64_t ListSnapshot_fnv1a(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    size_t i = 0;
+
+    for (i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV64_PRIME;
+    }
+
+    return hash;
+}
+
+static int ListSnapshot_write(FILE * out, const void *data, size_t size,
+        uint64_t * hash)
+{
+    check(fwrite(data, 1, size, out) == size, "Failed to write a record.");
+    *hash = ListSnapshot_fnv1a(*hash, data, size);
+    return 0;
+
+error:
+    return -1;
+}
+
+// a rename is only durable once the directory holding it is synced too
+static int ListSnapshot_sync_dir(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    char *dir = NULL;
+    int fd = -1;
+
+    if (slash == NULL) {
+        dir = strdup(".");
+    } else {
+        dir = strndup(path, slash == path ? 1 : (size_t)(slash - path));
+    }
+    check_mem(dir);
+
+    fd = open(dir, O_RDONLY | O_DIRECTORY);
+    check(fd >= 0, "Failed to open directory %s.", dir);
+    check(fsync(fd) == 0, "Failed to sync directory %s.", dir);
+
+    close(fd);
+    free(dir);
+    return 0;
+
+error:
+    if (fd >= 0) close(fd);
+    free(dir);
+    return -1;
+}
+
+int List_save(List * list, const char *path, List_snapshot_bytes bytes)
+{
+    static const unsigned char padding[8] = { 0 };
+    ListSnapshotHeader header = { .count = List_count(list) };
+    uint64_t hash = FNV64_OFFSET;
+    FILE *out = NULL;
+    char *tmp = malloc(strlen(path) + sizeof(".tmp"));
+
+    check_mem(tmp);
+    sprintf(tmp, "%s.tmp", path);
+    memcpy(header.magic, LIST_SNAPSHOT_MAGIC, sizeof(header.magic));
+
+    out = fopen(tmp, "wb");
+    check(out != NULL, "Failed to open %s.", tmp);
+    setvbuf(out, NULL, _IOFBF, LIST_SNAPSHOT_BUFFER);
+
+    // a placeholder, the real one goes in once the checksum is known
+    check(fwrite(&header, sizeof(header), 1, out) == 1,
+            "Failed to write the header.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        size_t size = 0;
+        const void *data = bytes(cur->value, &size);
+        uint64_t length = size;
+        check(data != NULL || size == 0, "No bytes for a value.");
+
+        check(ListSnapshot_write(out, &length, sizeof(length), &hash) == 0 &&
+                ListSnapshot_write(out, data, size, &hash) == 0 &&
+                ListSnapshot_write(out, padding,
+                    LIST_SNAPSHOT_PAD(size) - size, &hash) == 0,
+                "Failed to save the value at byte %" PRIu64 ".", header.bytes);
+
+        header.bytes += sizeof(length) + LIST_SNAPSHOT_PAD(size);
+    }
+
+    header.checksum = hash;
+    check(fseek(out, 0, SEEK_SET) == 0 &&
+            fwrite(&header, sizeof(header), 1, out) == 1,
+            "Failed to write the header.");
+
+    check(fflush(out) == 0 && fsync(fileno(out)) == 0, "Failed to write %s.",
+            tmp);
+    check(fclose(out) == 0, "Failed to close %s.", tmp);
+    out = NULL;
+
+    check(rename(tmp, path) == 0, "Failed to move %s to %s.", tmp, path);
+    check(ListSnapshot_sync_dir(path) == 0, "Failed to sync the rename of %s.",
+            path);
+
+    free(tmp);
+    return 0;
+
+error:
+    if (out) fclose(out);
+    if (tmp) remove(tmp);
+    free(tmp);
+    return -1;
+}
+
+ListSnapshot *List_load_mmap(const char *path)
+{
+    ListSnapshot *snap = NULL;
+    void *map = MAP_FAILED;
+    struct stat st;
+    int fd = -1;
+
+    fd = open(path, O_RDONLY);
+    check(fd >= 0, "Failed to open %s.", path);
+    check(fstat(fd, &st) == 0, "Failed to stat %s.", path);
+    check((size_t)st.st_size >= sizeof(ListSnapshotHeader),
+            "%s is too short to be a snapshot.", path);
+
+    map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    check(map != MAP_FAILED, "Failed to map %s.", path);
+
+    // the map keeps the file, the fd isn't needed anymore
+    close(fd);
+    fd = -1;
+
+    snap = calloc(1, sizeof(ListSnapshot));
+    check_mem(snap);
+
+    snap->map = map;
+    snap->map_size = st.st_size;
+    snap->header = map;
+    snap->records = snap->map + sizeof(ListSnapshotHeader);
+    snap->end = snap->map + snap->map_size;
+
+    check(memcmp(snap->header->magic, LIST_SNAPSHOT_MAGIC,
+                sizeof(snap->header->magic)) == 0,
+            "%s isn't a list snapshot.", path);
+    check(snap->header->bytes == snap->map_size - sizeof(ListSnapshotHeader),
+            "%s should have %" PRIu64 " bytes of records, has %zu.", path,
+            snap->header->bytes, snap->map_size - sizeof(ListSnapshotHeader));
+    // every record takes at least its length, and a List counts in an int
+    check(snap->header->count <= snap->header->bytes / sizeof(uint64_t) &&
+            snap->header->count <= INT_MAX,
+            "%s can't hold %" PRIu64 " records.", path, snap->header->count);
+
+    return snap;
+
+error:
+    if (fd >= 0) close(fd);
+    if (map != MAP_FAILED) munmap(map, st.st_size);
+    free(snap);
+    return NULL;
+}
+
+void ListSnapshot_close(ListSnapshot * snap)
+{
+    if (snap) {
+        munmap((void *)snap->map, snap->map_size);
+        free(snap);
+    }
+}
+
+int ListSnapshot_verify(ListSnapshot * snap)
+{
+    uint64_t hash = ListSnapshot_fnv1a(FNV64_OFFSET, snap->records,
+            snap->end - snap->records);
+    uint64_t count = 0;
+
+    check(hash == snap->header->checksum, "Snapshot checksum doesn't match.");
+
+    LIST_SNAPSHOT_FOREACH(snap, rec) {
+        count++;
+    }
+
+    check(count == snap->header->count,
+            "Snapshot has %" PRIu64 " records, its header says %" PRIu64 ".",
+            count, snap->header->count);
+
+    return 0;
+
+error:
+    return -1;
+}
+
+// the record at p, NULL if there's no whole record there
+static const ListSnapshotRecord *ListSnapshot_record_at(ListSnapshot * snap,
+        const unsigned char *p)
+{
+    const ListSnapshotRecord *rec = (const ListSnapshotRecord *)p;
+    size_t left = snap->end - p;
+
+    if (left < sizeof(ListSnapshotRecord) ||
+            rec->size > left - sizeof(ListSnapshotRecord)) {
+        return NULL;
+    }
+
+    return rec;
+}
+
+const ListSnapshotRecord *ListSnapshot_first(ListSnapshot * snap)
+{
+    return ListSnapshot_record_at(snap, snap->records);
+}
+
+const ListSnapshotRecord *ListSnapshot_next(ListSnapshot * snap,
+        const ListSnapshotRecord * rec)
+{
+    // size is in bounds, so padding it can't wrap, but it can run off the end
+    uint64_t step = LIST_SNAPSHOT_PAD(rec->size);
+
+    if (step >= (size_t)(snap->end - rec->data)) {
+        return NULL;
+    }
+
+    return ListSnapshot_record_at(snap, rec->data + step);
+}
+
+List *ListSnapshot_to_list(ListSnapshot * snap)
+{
+    void *values[LIST_SNAPSHOT_BATCH];
+    int count = ListSnapshot_count(snap);
+    int n = 0;
+
+    // a block as big as the whole list, so the nodes are one allocation
+    List *list = List_create_pooled(count > 0 ? count : 1);
+    check(list != NULL, "Failed to create the list.");
+
+    LIST_SNAPSHOT_FOREACH(snap, rec) {
+        values[n++] = (void *)rec->data;
+
+        if (n == LIST_SNAPSHOT_BATCH) {
+            check(List_push_many(list, values, n) == 0, "Failed to push.");
+            n = 0;
+        }
+    }
+
+    check(List_push_many(list, values, n) == 0, "Failed to push.");
+    check(List_count(list) == count,
+            "Snapshot has %d records, its header says %d.",
+            List_count(list), count);
+
+    return list;
+
+error:
+    if (list) List_destroy(list);
+    return NULL;
+}
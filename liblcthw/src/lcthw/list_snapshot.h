@@ -0,0 +1,90 @@
+#ifndef lcthw_List_snapshot_h
+#define lcthw_List_snapshot_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <lcthw/list.h>
+
+/*
+ * Snapshots: a list's values saved as flat bytes in one file, which
+ * loads with a single mmap and no parsing. Values are read in place,
+ * so a multi-GB snapshot only costs the pages actually touched:
+ *
+ *     List_save(list, "words.snap", str_bytes);
+ *     ...
+ *     ListSnapshot *snap = List_load_mmap("words.snap");
+ *     LIST_SNAPSHOT_FOREACH(snap, rec) {
+ *         puts((const char *)rec->data);
+ *     }
+ *     ListSnapshot_close(snap);
+ *
+ * The file is a header (magic, count, record bytes, FNV-1a 64 of the
+ * records) followed by the records, in this machine's byte order. Each
+ * record is a uint64_t length and then the bytes, padded so every record
+ * starts on an 8 byte boundary and a struct can be read straight out of
+ * the map.
+ */
+
+#define LIST_SNAPSHOT_MAGIC "LCTHWLS1"
+
+// the bytes to save for value, and how many there are
+typedef const void *(*List_snapshot_bytes) (const void *value, size_t *size);
+
+typedef struct ListSnapshotHeader {
+    char magic[8];
+    uint64_t count;
+    uint64_t bytes;
+    uint64_t checksum;
+} ListSnapshotHeader;
+
+typedef struct ListSnapshotRecord {
+    uint64_t size;
+    unsigned char data[];
+} ListSnapshotRecord;
+
+typedef struct ListSnapshot {
+    const unsigned char *map;
+    size_t map_size;
+    const ListSnapshotHeader *header;
+    const unsigned char *records;
+    const unsigned char *end;
+} ListSnapshot;
+
+/*
+ * Writes to path.tmp and renames it over path once it's all on disk,
+ * then syncs the directory, so a crash halfway through leaves the last
+ * good snapshot alone.
+ */
+int List_save(List * list, const char *path, List_snapshot_bytes bytes);
+
+/*
+ * Maps the file and checks the header, and nothing past it, so this is
+ * O(1) in the size of the file. ListSnapshot_verify checks the rest.
+ */
+ListSnapshot *List_load_mmap(const char *path);
+void ListSnapshot_close(ListSnapshot * snap);
+
+// reads every record to check the checksum, 0 if it matches
+int ListSnapshot_verify(ListSnapshot * snap);
+
+#define ListSnapshot_count(S) ((int)(S)->header->count)
+
+/*
+ * Records in order, NULL after the last. A record whose length would
+ * run past the end of the file ends the walk too, so a corrupt file
+ * can't send it outside the map.
+ */
+const ListSnapshotRecord *ListSnapshot_first(ListSnapshot * snap);
+const ListSnapshotRecord *ListSnapshot_next(ListSnapshot * snap,
+        const ListSnapshotRecord * rec);
+
+/*
+ * A pooled list of pointers to each record's data in the map, which has
+ * to stay open as long as the list is used.
+ */
+List *ListSnapshot_to_list(ListSnapshot * snap);
+
+#define LIST_SNAPSHOT_FOREACH(S, V) const ListSnapshotRecord *V = NULL;\
+for(V = ListSnapshot_first(S); V != NULL; V = ListSnapshot_next(S, V))
+
+#endif
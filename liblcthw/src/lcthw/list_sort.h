@@ -0,0 +1,95 @@
+#ifndef lcthw_List_sort_h
+#define lcthw_List_sort_h
+
+#include <lcthw/list.h>
+#include <string.h>
+
+/*
+ * Compile time specialized versions of List_merge_sort. Instead of a
+ * List_compare pointer they take CMP, a function-like macro that gets
+ * two values of value_type and returns <0, 0 or >0 like strcmp, so the
+ * compiler can inline every comparison:
+ *
+ *     LIST_DEFINE_SORT(List_sort_int, int *, LIST_CMP_INT)
+ *     ...
+ *     List_sort_int(list);
+ *
+ * The generated sort is the same stable, in-place bottom-up merge sort.
+ */
+
+#define LIST_CMP_INT(A, B) ((*(A) > *(B)) - (*(A) < *(B)))
+
+// a direct call the compiler can see, not one through a pointer
+#define LIST_CMP_STR(A, B) strcmp((A), (B))
+#define LIST_SORT_CAST(N, T) ((T)(N)->value)
+
+#define LIST_DEFINE_SORT(name, value_type, CMP)\
+    LIST_DEFINE_NODE_SORT(name, List, ListNode, value_type, LIST_SORT_CAST, CMP)
+
+/*
+ * The generic version behind LIST_DEFINE_SORT, for any list type with
+ * first/last/count and nodes with next/prev. KEY(node, key_type) pulls
+ * the value CMP works on out of a node.
+ */
+#define LIST_DEFINE_NODE_SORT(name, list_type, node_type, key_type, KEY, CMP)\
+static inline node_type *name##_merge(node_type *left, node_type *right)\
+{\
+    node_type head;\
+    node_type *tail = &head;\
+\
+    while (left != NULL && right != NULL) {\
+        if (CMP(KEY(left, key_type), KEY(right, key_type)) <= 0) {\
+            tail->next = left;\
+            left = left->next;\
+        } else {\
+            tail->next = right;\
+            right = right->next;\
+        }\
+        tail = tail->next;\
+    }\
+\
+    tail->next = left != NULL ? left : right;\
+    return head.next;\
+}\
+\
+static list_type *name(list_type *list)\
+{\
+    node_type *bins[64] = { NULL };\
+    node_type *head = list->first;\
+    node_type *prev = NULL;\
+    int max_bin = 0;\
+    int i = 0;\
+\
+    if (list->count <= 1) {\
+        return list;\
+    }\
+\
+    while (head != NULL) {\
+        node_type *run = head;\
+        head = head->next;\
+        run->next = NULL;\
+\
+        for (i = 0; bins[i] != NULL; i++) {\
+            run = name##_merge(bins[i], run);\
+            bins[i] = NULL;\
+        }\
+\
+        bins[i] = run;\
+        if (i > max_bin) max_bin = i;\
+    }\
+\
+    for (i = 0; i <= max_bin; i++) {\
+        if (bins[i] != NULL) head = name##_merge(bins[i], head);\
+    }\
+\
+    list->first = head;\
+    for (; head != NULL; head = head->next) {\
+        head->prev = prev;\
+        prev = head;\
+    }\
+    list->last = prev;\
+\
+    return list;\
+}
+
+#endif
@@ -0,0 +1,355 @@
+#include <lcthw/plist.h>
+#include <lcthw/darray.h>
+#include <lcthw/dbg.h>
+#include <string.h>
+
+#define PLIST_RECLAIM_EVERY 64
+#define PLIST_LIMBO_START 256
+
+/*
+ * Epochs: a reader publishes the global epoch it saw when it took its
+ * first snapshot. The epoch only moves on once every reader holding a
+ * snapshot has seen the current one, so anything retired in epoch e is
+ * out of every reader's reach by e + 2. Records live on one list for
+ * all PLists and are never freed, a thread that exits hands its record
+ * to the next one, like the hazard records in lfqueue.c.
+ */
+
+typedef struct PListEpochRecord {
+    atomic_ulong epoch;
+    // how many snapshots the owner holds, 0 when it's outside
+    atomic_int active;
+    atomic_int in_use;
+    struct PListEpochRecord *next;
+} PListEpochRecord;
+
+typedef struct PListRetired {
+    void *ptr;
+    unsigned long epoch;
+} PListRetired;
+
+static _Atomic(PListEpochRecord *) plist_records = NULL;
+static atomic_ulong plist_epoch = 0;
+static pthread_key_t plist_key;
+static pthread_once_t plist_once = PTHREAD_ONCE_INIT;
+static _Thread_local PListEpochRecord *plist_mine = NULL;
+
+static void PListEpochRecord_release(void *arg)
+{
+    PListEpochRecord *rec = arg;
+
+    atomic_store(&rec->active, 0);
+    atomic_store(&rec->in_use, 0);
+}
+
+static void PList_epoch_init()
+{
+    pthread_key_create(&plist_key, PListEpochRecord_release);
+}
+
+static PListEpochRecord *PListEpochRecord_get()
+{
+    PListEpochRecord *rec = plist_mine;
+
+    if (rec != NULL) {
+        return rec;
+    }
+
+    pthread_once(&plist_once, PList_epoch_init);
+
+    // reuse a record some finished thread gave back
+    for (rec = atomic_load(&plist_records); rec != NULL; rec = rec->next) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&rec->in_use, &expected, 1)) {
+            break;
+        }
+    }
+
+    if (rec == NULL) {
+        rec = calloc(1, sizeof(PListEpochRecord));
+        check_mem(rec);
+
+        atomic_store(&rec->in_use, 1);
+
+        PListEpochRecord *head = atomic_load(&plist_records);
+        do {
+            rec->next = head;
+        } while (!atomic_compare_exchange_weak(&plist_records, &head, rec));
+    }
+
+    pthread_setspecific(plist_key, rec);
+    plist_mine = rec;
+
+error:          // fallthrough
+    return rec;
+}
+
+static int PList_enter()
+{
+    PListEpochRecord *rec = PListEpochRecord_get();
+    check(rec != NULL, "No epoch record for this thread.");
+
+    int depth = atomic_load_explicit(&rec->active, memory_order_relaxed);
+
+    // active first, so a writer can't miss a reader that's about to look
+    atomic_store(&rec->active, depth + 1);
+    if (depth == 0) {
+        atomic_store(&rec->epoch, atomic_load(&plist_epoch));
+    }
+
+    return 0;
+
+error:
+    return -1;
+}
+
+static void PList_exit()
+{
+    PListEpochRecord *rec = plist_mine;
+
+    if (rec != NULL) {
+        int depth = atomic_load_explicit(&rec->active, memory_order_relaxed);
+        check(depth > 0, "Released a snapshot this thread doesn't hold.");
+        atomic_store_explicit(&rec->active, depth - 1, memory_order_release);
+    }
+
+error:          // fallthrough
+    return;
+}
+
+// moves the epoch on if every reader inside has caught up with it
+static void PList_try_advance()
+{
+    unsigned long epoch = atomic_load(&plist_epoch);
+    PListEpochRecord *rec = NULL;
+
+    for (rec = atomic_load(&plist_records); rec != NULL; rec = rec->next) {
+        if (atomic_load(&rec->active) > 0 && atomic_load(&rec->epoch) != epoch) {
+            return;
+        }
+    }
+
+    atomic_compare_exchange_strong(&plist_epoch, &epoch, epoch + 1);
+}
+
+/*
+ * Frees everything retired at least two epochs ago, under list->lock.
+ * Items go into limbo in epoch order, so that's a run from the front.
+ */
+static void PList_collect(PList * list)
+{
+    DArray *limbo = list->limbo;
+    unsigned long epoch = 0;
+
+    PList_try_advance();
+    epoch = atomic_load(&plist_epoch);
+
+    while (list->limbo_head < DArray_count(limbo)) {
+        PListRetired *item = DArray_get(limbo, list->limbo_head);
+
+        if (item->epoch + 2 > epoch) {
+            break;
+        }
+
+        free(item->ptr);
+        list->limbo_head++;
+    }
+
+    if (list->limbo_head == DArray_count(limbo)) {
+        limbo->end = list->limbo_head = 0;
+    } else if (list->limbo_head >= PLIST_LIMBO_START &&
+            list->limbo_head * 2 >= DArray_count(limbo)) {
+        // what's left is at most as big as what's gone, so this is cheap
+        memmove(DArray_slot(limbo, 0), DArray_slot(limbo, list->limbo_head),
+                (DArray_count(limbo) - list->limbo_head) * sizeof(PListRetired));
+        limbo->end -= list->limbo_head;
+        list->limbo_head = 0;
+    }
+}
+
+static void PList_retire(PList * list, void *ptr)
+{
+    PListRetired item = { ptr, atomic_load(&plist_epoch) };
+
+    // if it can't be tracked it can't be freed safely, so it leaks
+    check(DArray_push(list->limbo, &item) == 0, "Failed to retire, leaking.");
+
+    if (++list->retired % PLIST_RECLAIM_EVERY == 0) {
+        PList_collect(list);
+    }
+
+error:          // fallthrough
+    return;
+}
+
+PList *PList_create()
+{
+    PList *list = calloc(1, sizeof(PList));
+    check_mem(list);
+
+    list->limbo = DArray_create_inline(sizeof(PListRetired), PLIST_LIMBO_START);
+    check_mem(list->limbo);
+
+    PListVersion *empty = calloc(1, sizeof(PListVersion));
+    check_mem(empty);
+
+    atomic_init(&list->current, empty);
+    pthread_mutex_init(&list->lock, NULL);
+
+    return list;
+
+error:
+    if (list) DArray_destroy(list->limbo);
+    free(list);
+    return NULL;
+}
+
+void PList_destroy(PList * list)
+{
+    int i = 0;
+
+    if (list) {
+        PListVersion *version = atomic_load(&list->current);
+        PListNode *node = version->first;
+
+        for (i = 0; i < version->count; i++) {
+            PListNode *next = node->next;
+            free(node);
+            node = next;
+        }
+        free(version);
+
+        for (i = list->limbo_head; i < DArray_count(list->limbo); i++) {
+            PListRetired *item = DArray_get(list->limbo, i);
+            free(item->ptr);
+        }
+
+        DArray_destroy(list->limbo);
+        pthread_mutex_destroy(&list->lock);
+        free(list);
+    }
+}
+
+int PList_push(PList * list, void *value)
+{
+    PListNode *node = calloc(1, sizeof(PListNode));
+    PListVersion *version = malloc(sizeof(PListVersion));
+
+    check_mem(node);
+    check_mem(version);
+    node->value = value;
+
+    pthread_mutex_lock(&list->lock);
+
+    // only writers store current, and they all hold the lock
+    PListVersion *old = atomic_load_explicit(&list->current,
+            memory_order_relaxed);
+    *version = *old;
+
+    // no older version goes past its own last, so nobody reads this next
+    if (old->last != NULL) {
+        old->last->next = node;
+    } else {
+        version->first = node;
+    }
+
+    version->last = node;
+    version->count++;
+
+    // seq_cst, so the epoch retire reads can't be older than a reader
+    // that still finds old here
+    atomic_store(&list->current, version);
+    PList_retire(list, old);
+
+    pthread_mutex_unlock(&list->lock);
+    return 0;
+
+error:
+    free(node);
+    free(version);
+    return -1;
+}
+
+void *PList_shift(PList * list)
+{
+    PListVersion *version = malloc(sizeof(PListVersion));
+    void *value = NULL;
+
+    check_mem(version);
+
+    pthread_mutex_lock(&list->lock);
+
+    PListVersion *old = atomic_load_explicit(&list->current,
+            memory_order_relaxed);
+
+    if (old->count == 0) {
+        pthread_mutex_unlock(&list->lock);
+        free(version);
+        return NULL;
+    }
+
+    PListNode *node = old->first;
+    value = node->value;
+
+    if (old->count == 1) {
+        version->first = version->last = NULL;
+    } else {
+        version->first = node->next;
+        version->last = old->last;
+    }
+    version->count = old->count - 1;
+
+    atomic_store(&list->current, version);
+    PList_retire(list, old);
+    PList_retire(list, node);
+
+    pthread_mutex_unlock(&list->lock);
+
+error:          // fallthrough
+    return value;
+}
+
+int PList_count(PList * list)
+{
+    PListSnapshot snap = PList_snapshot(list);
+    int count = snap.count;
+
+    PList_release(&snap);
+    return count;
+}
+
+PListSnapshot PList_snapshot(PList * list)
+{
+    PListSnapshot snap = { NULL, NULL, 0, 0 };
+    PListVersion *version = NULL;
+
+    check(PList_enter() == 0, "Can't protect a snapshot, giving an empty one.");
+
+    // pairs with the writer's seq_cst publish, see PList_push
+    version = atomic_load(&list->current);
+    snap.first = version->first;
+    snap.last = version->last;
+    snap.count = version->count;
+    snap.held = 1;
+
+error:          // fallthrough
+    return snap;
+}
+
+void PList_release(PListSnapshot * snap)
+{
+    if (snap->held) {
+        PList_exit();
+    }
+
+    snap->first = snap->last = NULL;
+    snap->count = 0;
+    snap->held = 0;
+}
+
+void PList_reclaim(PList * list)
+{
+    pthread_mutex_lock(&list->lock);
+    PList_collect(list);
+    pthread_mutex_unlock(&list->lock);
+}
@@ -0,0 +1,86 @@
+#ifndef lcthw_PList_h
+#define lcthw_PList_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+struct DArray;
+
+/*
+ * Persistent list for many readers and a few writers. Every push or
+ * shift publishes a new version, {first, last, count}, with one atomic
+ * store, and versions share all of their nodes: a push links a node on
+ * after the last one, which older versions never look past, and a shift
+ * just starts the next version one node later. Readers never lock:
+ *
+ *     PListSnapshot snap = PList_snapshot(list);
+ *     PLIST_FOREACH(snap, cur) {
+ *         total += *(int *)cur->value;
+ *     }
+ *     PList_release(&snap);
+ *
+ * A snapshot sees the list exactly as it was when it was taken, however
+ * long it's held. Writers take a mutex against each other. Shifted nodes
+ * and old versions are freed by epoch based reclamation, once no reader
+ * that might still see them is left. So only push and shift, no removing
+ * from the middle or the end, which would need to change a node that an
+ * older version still has.
+ */
+
+typedef struct PListNode {
+    struct PListNode *next;
+    void *value;
+} PListNode;
+
+typedef struct PListVersion {
+    PListNode *first;
+    PListNode *last;
+    int count;
+} PListVersion;
+
+typedef struct PList {
+    _Atomic(PListVersion *) current;
+    pthread_mutex_t lock;
+    // nodes and versions waiting for readers to move on, oldest from
+    // limbo_head on, all under lock
+    struct DArray *limbo;
+    int limbo_head;
+    int retired;
+} PList;
+
+// a version of the list, good until it's released
+typedef struct PListSnapshot {
+    PListNode *first;
+    PListNode *last;
+    int count;
+    // cleared by release, so releasing twice does nothing
+    int held;
+} PListSnapshot;
+
+PList *PList_create();
+// frees every node, no reader can still hold a snapshot
+void PList_destroy(PList * list);
+
+int PList_push(PList * list, void *value);
+// NULL when the list is empty
+void *PList_shift(PList * list);
+
+int PList_count(PList * list);
+
+/*
+ * Snapshots nest, and each has to be released on the thread that took
+ * it. While any is held the thread holds back reclamation, so don't sit
+ * on one forever.
+ */
+PListSnapshot PList_snapshot(PList * list);
+void PList_release(PListSnapshot * snap);
+
+// frees what's safe to free now instead of waiting for more retires
+void PList_reclaim(PList * list);
+
+// stops at last, whatever last->next is by now belongs to a later version
+#define PLIST_FOREACH(S, V) PListNode *V = NULL;\
+for(V = (S).first; V != NULL; V = V == (S).last ? NULL : V->next)
+
+#endif
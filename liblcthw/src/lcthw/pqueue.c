@@ -0,0 +1,242 @@
+#include <lcthw/pqueue.h>
+#include <lcthw/dbg.h>
+
+// spare nodes kept however small the queue gets
+#define PQUEUE_SPARE_MIN 64
+
+#define PQueue_at(Q, I) (((PQueueNode **)(Q)->heap->contents)[(I)])
+
+PQueue *PQueue_create(List_compare cmp)
+{
+    PQueue *queue = calloc(1, sizeof(PQueue));
+    check_mem(queue);
+
+    queue->cmp = cmp;
+    queue->heap = DArray_create(sizeof(PQueueNode *), 64);
+    check(queue->heap != NULL, "Failed to create the heap.");
+    queue->spare = DArray_create(sizeof(PQueueNode *), 64);
+    check(queue->spare != NULL, "Failed to create the spare nodes.");
+
+    return queue;
+
+error:
+    PQueue_destroy(queue);
+    return NULL;
+}
+
+void PQueue_destroy(PQueue * queue)
+{
+    int i = 0;
+
+    if (queue) {
+        if (queue->heap) {
+            for (i = 0; i < DArray_count(queue->heap); i++) {
+                free(PQueue_at(queue, i));
+            }
+            DArray_destroy(queue->heap);
+        }
+
+        if (queue->spare) {
+            for (i = 0; i < DArray_count(queue->spare); i++) {
+                free(DArray_get(queue->spare, i));
+            }
+            DArray_destroy(queue->spare);
+        }
+
+        free(queue);
+    }
+}
+
+/*
+ * Both sifts carry the moving node in a hole instead of swapping, so
+ * each level is one store and one index update.
+ */
+static void PQueue_sift_up(PQueue * queue, int i)
+{
+    PQueueNode *node = PQueue_at(queue, i);
+
+    while (i > 0) {
+        int parent = (i - 1) / PQUEUE_ARITY;
+        PQueueNode *up = PQueue_at(queue, parent);
+
+        if (queue->cmp(node->value, up->value) >= 0) {
+            break;
+        }
+
+        PQueue_at(queue, i) = up;
+        up->index = i;
+        i = parent;
+    }
+
+    PQueue_at(queue, i) = node;
+    node->index = i;
+}
+
+static void PQueue_sift_down(PQueue * queue, int i)
+{
+    PQueueNode *node = PQueue_at(queue, i);
+    int count = PQueue_count(queue);
+
+    while (1) {
+        int first = i * PQUEUE_ARITY + 1;
+        int last = first + PQUEUE_ARITY;
+        int best = first;
+        int child = 0;
+
+        if (first >= count) {
+            break;
+        }
+
+        if (last > count) {
+            last = count;
+        }
+
+        for (child = first + 1; child < last; child++) {
+            if (queue->cmp(PQueue_at(queue, child)->value,
+                        PQueue_at(queue, best)->value) < 0) {
+                best = child;
+            }
+        }
+
+        if (queue->cmp(PQueue_at(queue, best)->value, node->value) >= 0) {
+            break;
+        }
+
+        PQueue_at(queue, i) = PQueue_at(queue, best);
+        PQueue_at(queue, i)->index = i;
+        i = best;
+    }
+
+    PQueue_at(queue, i) = node;
+    node->index = i;
+}
+
+static PQueueNode *PQueueNode_alloc(PQueue * queue, void *value)
+{
+    PQueueNode *node = NULL;
+
+    if (DArray_count(queue->spare) > 0) {
+        node = DArray_pop(queue->spare);
+    } else {
+        node = malloc(sizeof(PQueueNode));
+        check_mem(node);
+    }
+
+    node->value = value;
+    node->index = -1;
+    return node;
+
+error:
+    return NULL;
+}
+
+PQueue *PQueue_from_list(List * list, List_compare cmp)
+{
+    PQueue *queue = PQueue_create(cmp);
+    int i = 0;
+
+    check(queue != NULL, "Failed to create queue.");
+
+    if (List_count(list) > DArray_max(queue->heap)) {
+        check(DArray_expand(queue->heap, List_count(list)) == 0,
+                "Failed to size the heap.");
+    }
+
+    LIST_FOREACH(list, first, next, cur) {
+        PQueueNode *node = PQueueNode_alloc(queue, cur->value);
+        check(node != NULL, "Failed to make a node.");
+
+        node->index = DArray_count(queue->heap);
+        if (DArray_push(queue->heap, node) != 0) {
+            free(node);
+            sentinel("Failed to grow the heap.");
+        }
+    }
+
+    // sift down every parent, bottom up, the leaves are heaps already
+    if (PQueue_count(queue) > 1) {
+        for (i = (PQueue_count(queue) - 2) / PQUEUE_ARITY; i >= 0; i--) {
+            PQueue_sift_down(queue, i);
+        }
+    }
+
+    return queue;
+
+error:
+    PQueue_destroy(queue);
+    return NULL;
+}
+
+PQueueNode *PQueue_push(PQueue * queue, void *value)
+{
+    PQueueNode *node = PQueueNode_alloc(queue, value);
+    check(node != NULL, "Failed to make a node.");
+
+    if (DArray_push(queue->heap, node) != 0) {
+        free(node);
+        sentinel("Failed to grow the heap.");
+    }
+
+    PQueue_sift_up(queue, PQueue_count(queue) - 1);
+    return node;
+
+error:
+    return NULL;
+}
+
+void *PQueue_peek(PQueue * queue)
+{
+    return PQueue_count(queue) > 0 ? PQueue_at(queue, 0)->value : NULL;
+}
+
+void *PQueue_pop(PQueue * queue)
+{
+    PQueueNode *top = NULL;
+    PQueueNode *last = NULL;
+    void *value = NULL;
+
+    if (PQueue_count(queue) == 0) {
+        return NULL;
+    }
+
+    top = PQueue_at(queue, 0);
+    last = DArray_pop(queue->heap);
+
+    if (last != top) {
+        PQueue_at(queue, 0) = last;
+        PQueue_sift_down(queue, 0);
+    }
+
+    value = top->value;
+    top->value = NULL;
+    top->index = -1;
+
+    if (DArray_push(queue->spare, top) != 0) {
+        free(top);
+    }
+
+    // no more spares than the queue holds, so a drained queue shrinks,
+    // the heap loses one a pop so this frees at most two
+    while (DArray_count(queue->spare) > PQUEUE_SPARE_MIN &&
+            DArray_count(queue->spare) > PQueue_count(queue)) {
+        free(DArray_pop(queue->spare));
+    }
+
+    return value;
+}
+
+int PQueue_update(PQueue * queue, PQueueNode * node, void *value)
+{
+    check(node->index >= 0 && node->index < PQueue_count(queue) &&
+            PQueue_at(queue, node->index) == node,
+            "Node isn't in this queue.");
+
+    node->value = value;
+    PQueue_sift_up(queue, node->index);
+    PQueue_sift_down(queue, node->index);
+
+    return 0;
+
+error:
+    return -1;
+}
@@ -0,0 +1,44 @@
+#ifndef lcthw_PQueue_h
+#define lcthw_PQueue_h
+
+#include <lcthw/darray.h>
+#include <lcthw/list.h>
+#include <lcthw/list_algos.h>
+
+/*
+ * Priority queue on a 4-ary heap kept in a DArray, smallest first by
+ * cmp. PQueue_push hands back a PQueueNode that stays put while the
+ * value moves around the heap, so a caller can change its priority
+ * later with PQueue_update. A node is only good until its value is
+ * popped, after that the queue reuses it.
+ */
+
+#define PQUEUE_ARITY 4
+
+typedef struct PQueueNode {
+    void *value;
+    int index;
+} PQueueNode;
+
+typedef struct PQueue {
+    List_compare cmp;
+    DArray *heap;
+    DArray *spare;
+} PQueue;
+
+PQueue *PQueue_create(List_compare cmp);
+void PQueue_destroy(PQueue * queue);
+
+// builds the heap in one O(n) pass instead of n pushes
+PQueue *PQueue_from_list(List * list, List_compare cmp);
+
+#define PQueue_count(A) DArray_count((A)->heap)
+
+PQueueNode *PQueue_push(PQueue * queue, void *value);
+void *PQueue_pop(PQueue * queue);
+void *PQueue_peek(PQueue * queue);
+
+// sets node's value and moves it to its new place, up or down
+int PQueue_update(PQueue * queue, PQueueNode * node, void *value);
+
+#endif
@@ -0,0 +1,234 @@
+#include <lcthw/skiplist.h>
+#include <lcthw/dbg.h>
+#include <string.h>
+
+#define SKIPLIST_BLOCK_SIZE (64 * 1024)
+
+typedef struct SkipListBlock {
+    struct SkipListBlock *next;
+    size_t used;
+    char data[];
+} SkipListBlock;
+
+// towers of each height get their own free list, threaded through next[0]
+typedef struct SkipListArena {
+    SkipListBlock *blocks;
+    SkipListNode *free[SKIPLIST_MAX_LEVEL + 1];
+} SkipListArena;
+
+#define SkipListNode_size(H) (sizeof(SkipListNode) + (H) * sizeof(SkipListNode *))
+
+static SkipListNode *SkipListNode_alloc(SkipList * list, int height)
+{
+    SkipListArena *arena = list->arena;
+    size_t size = SkipListNode_size(height);
+    SkipListNode *node = arena->free[height];
+
+    if (node != NULL) {
+        arena->free[height] = node->next[0];
+    } else {
+        SkipListBlock *block = arena->blocks;
+
+        if (block == NULL || block->used + size > SKIPLIST_BLOCK_SIZE) {
+            block = malloc(sizeof(SkipListBlock) + SKIPLIST_BLOCK_SIZE);
+            check_mem(block);
+
+            block->next = arena->blocks;
+            block->used = 0;
+            arena->blocks = block;
+        }
+
+        node = (SkipListNode *)&block->data[block->used];
+        block->used += size;
+    }
+
+    memset(node, 0, size);
+    node->height = height;
+    return node;
+
+error:
+    return NULL;
+}
+
+static inline void SkipListNode_free(SkipList * list, SkipListNode * node)
+{
+    node->next[0] = list->arena->free[node->height];
+    list->arena->free[node->height] = node;
+}
+
+SkipList *SkipList_create(List_compare cmp)
+{
+    SkipList *list = calloc(1, sizeof(SkipList));
+    check_mem(list);
+
+    list->arena = calloc(1, sizeof(SkipListArena));
+    check_mem(list->arena);
+
+    list->cmp = cmp;
+    list->level = 1;
+    list->seed = 2463534242u;
+    list->head = SkipListNode_alloc(list, SKIPLIST_MAX_LEVEL);
+    check(list->head != NULL, "Failed to make the head tower.");
+
+    return list;
+
+error:
+    SkipList_destroy(list);
+    return NULL;
+}
+
+void SkipList_destroy(SkipList * list)
+{
+    if (list) {
+        if (list->arena) {
+            SkipListBlock *block = list->arena->blocks;
+
+            while (block != NULL) {
+                SkipListBlock *next = block->next;
+                free(block);
+                block = next;
+            }
+
+            free(list->arena);
+        }
+
+        free(list);
+    }
+}
+
+// each level up is taken with probability 1/4, two random bits a level
+static int SkipList_random_height(SkipList * list)
+{
+    unsigned int x = list->seed;
+    int height = 1;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    list->seed = x;
+
+    while ((x & 3) == 0 && height < SKIPLIST_MAX_LEVEL) {
+        height++;
+        x >>= 2;
+    }
+
+    return height;
+}
+
+/*
+ * Fills update with the last node on each level that comes before
+ * value. With after_equal set that includes the nodes equal to it,
+ * which is where an insert goes to keep equal values in order.
+ */
+static SkipListNode *SkipList_seek(SkipList * list, void *value,
+        int after_equal, SkipListNode ** update)
+{
+    SkipListNode *x = list->head;
+    int i = 0;
+
+    for (i = list->level - 1; i >= 0; i--) {
+        while (x->next[i] != NULL) {
+            int rc = list->cmp(x->next[i]->value, value);
+
+            if (rc > 0 || (rc == 0 && !after_equal)) {
+                break;
+            }
+
+            x = x->next[i];
+        }
+
+        if (update != NULL) {
+            update[i] = x;
+        }
+    }
+
+    return x;
+}
+
+SkipListNode *SkipList_insert(SkipList * list, void *value)
+{
+    SkipListNode *update[SKIPLIST_MAX_LEVEL];
+    SkipListNode *node = NULL;
+    int height = SkipList_random_height(list);
+    int i = 0;
+
+    SkipList_seek(list, value, 1, update);
+
+    node = SkipListNode_alloc(list, height);
+    check(node != NULL, "Failed to make a tower.");
+
+    for (i = list->level; i < height; i++) {
+        update[i] = list->head;
+    }
+    if (height > list->level) {
+        list->level = height;
+    }
+
+    node->value = value;
+    for (i = 0; i < height; i++) {
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+
+    node->prev = update[0] == list->head ? NULL : update[0];
+    if (node->next[0] != NULL) {
+        node->next[0]->prev = node;
+    } else {
+        list->last = node;
+    }
+
+    list->count++;
+    return node;
+
+error:
+    return NULL;
+}
+
+void *SkipList_delete(SkipList * list, void *value)
+{
+    SkipListNode *update[SKIPLIST_MAX_LEVEL];
+    SkipListNode *node = NULL;
+    void *result = NULL;
+    int i = 0;
+
+    node = SkipList_seek(list, value, 0, update)->next[0];
+    if (node == NULL || list->cmp(node->value, value) != 0) {
+        return NULL;
+    }
+
+    for (i = 0; i < node->height; i++) {
+        update[i]->next[i] = node->next[i];
+    }
+
+    if (node->next[0] != NULL) {
+        node->next[0]->prev = node->prev;
+    } else {
+        list->last = node->prev;
+    }
+
+    while (list->level > 1 && list->head->next[list->level - 1] == NULL) {
+        list->level--;
+    }
+
+    result = node->value;
+    SkipListNode_free(list, node);
+    list->count--;
+
+    return result;
+}
+
+SkipListNode *SkipList_lower_bound(SkipList * list, void *value)
+{
+    return SkipList_seek(list, value, 0, NULL)->next[0];
+}
+
+SkipListNode *SkipList_find(SkipList * list, void *value)
+{
+    SkipListNode *node = SkipList_lower_bound(list, value);
+
+    if (node != NULL && list->cmp(node->value, value) == 0) {
+        return node;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,72 @@
+#ifndef lcthw_SkipList_h
+#define lcthw_SkipList_h
+
+#include <stdlib.h>
+#include <lcthw/list_algos.h>
+
+/*
+ * Ordered container kept sorted by cmp as values go in, with O(log n)
+ * insert, delete and seek. Equal values stay in insertion order. Level 0
+ * is a doubly linked list, so once you've found a node you can walk
+ * either way from it like a List:
+ *
+ *     SkipListNode *from = SkipList_lower_bound(list, &low);
+ *     SKIPLIST_FOREACH_FROM(from, next, cur) {
+ *         if (cmp(cur->value, &high) > 0) break;
+ *         ...
+ *     }
+ *
+ * Towers are carved out of blocks owned by the list and reused after
+ * a delete.
+ */
+
+#define SKIPLIST_MAX_LEVEL 16
+
+struct SkipListNode;
+struct SkipListArena;
+
+typedef struct SkipListNode {
+    void *value;
+    struct SkipListNode *prev;
+    int height;
+    struct SkipListNode *next[];
+} SkipListNode;
+
+typedef struct SkipList {
+    int count;
+    int level;
+    unsigned int seed;
+    List_compare cmp;
+    SkipListNode *head;
+    SkipListNode *last;
+    struct SkipListArena *arena;
+} SkipList;
+
+SkipList *SkipList_create(List_compare cmp);
+void SkipList_destroy(SkipList * list);
+
+#define SkipList_count(A) ((A)->count)
+#define SkipList_first(A) ((A)->head->next[0])
+#define SkipList_last(A) ((A)->last)
+
+#define SkipListNode_next(N) ((N)->next[0])
+#define SkipListNode_prev(N) ((N)->prev)
+
+SkipListNode *SkipList_insert(SkipList * list, void *value);
+
+// removes the first node equal to value and returns its value
+void *SkipList_delete(SkipList * list, void *value);
+
+// first node equal to value, or NULL
+SkipListNode *SkipList_find(SkipList * list, void *value);
+
+// first node not less than value, or NULL when they all are
+SkipListNode *SkipList_lower_bound(SkipList * list, void *value);
+
+#define SKIPLIST_FOREACH_FROM(N, M, V) SkipListNode *_snode = NULL;\
+                                                     SkipListNode *V = NULL;\
+for(V = _snode = (N); _snode != NULL; V = _snode = SkipListNode_##M(_snode))
+
+#define SKIPLIST_FOREACH(L, S, M, V) SKIPLIST_FOREACH_FROM(SkipList_##S(L), M, V)
+
+#endif
@@ -0,0 +1,264 @@
+#include <lcthw/threadpool.h>
+#include <lcthw/dbg.h>
+
+#define THREADPOOL_MIN_CAPACITY 16
+
+// the worker running on this thread, NULL outside a pool
+static _Thread_local ThreadPoolWorker *ThreadPool_current = NULL;
+
+static int ThreadPoolWorker_push(ThreadPoolWorker * worker, ThreadPoolTask task)
+{
+    int rc = -1;
+
+    pthread_mutex_lock(&worker->lock);
+
+    if (worker->count == worker->capacity) {
+        int capacity = worker->capacity < THREADPOOL_MIN_CAPACITY ?
+            THREADPOOL_MIN_CAPACITY : worker->capacity * 2;
+        ThreadPoolTask *tasks = malloc(capacity * sizeof(ThreadPoolTask));
+        check_mem(tasks);
+
+        // unwrap the ring so head starts over at 0
+        int i = 0;
+        for (i = 0; i < worker->count; i++) {
+            tasks[i] = worker->tasks[(worker->head + i) % worker->capacity];
+        }
+
+        free(worker->tasks);
+        worker->tasks = tasks;
+        worker->capacity = capacity;
+        worker->head = 0;
+    }
+
+    worker->tasks[(worker->head + worker->count) % worker->capacity] = task;
+    worker->count++;
+    rc = 0;
+
+error:          // fallthrough
+    pthread_mutex_unlock(&worker->lock);
+    return rc;
+}
+
+// the owner takes the newest task, a thief the oldest
+static int ThreadPoolWorker_take(ThreadPoolWorker * worker,
+        ThreadPoolTask * task, int steal)
+{
+    int found = 0;
+
+    pthread_mutex_lock(&worker->lock);
+
+    if (worker->count > 0) {
+        if (steal) {
+            *task = worker->tasks[worker->head];
+            worker->head = (worker->head + 1) % worker->capacity;
+        } else {
+            *task = worker->tasks[(worker->head + worker->count - 1) %
+                worker->capacity];
+        }
+
+        worker->count--;
+        found = 1;
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+    return found;
+}
+
+static ThreadPoolWorker *ThreadPool_self(ThreadPool * pool)
+{
+    return ThreadPool_current != NULL && ThreadPool_current->pool == pool ?
+        ThreadPool_current : NULL;
+}
+
+int ThreadPool_run_one(ThreadPool * pool)
+{
+    ThreadPoolWorker *self = ThreadPool_self(pool);
+    ThreadPoolTask task;
+    unsigned int start = 0;
+    int found = 0;
+    int i = 0;
+
+    if (atomic_load(&pool->queued) <= 0) {
+        return 0;
+    }
+
+    if (self != NULL) {
+        found = ThreadPoolWorker_take(self, &task, 0);
+        start = self - pool->workers + 1;
+    } else {
+        start = atomic_load(&pool->next);
+    }
+
+    for (i = 0; !found && i < pool->nthreads; i++) {
+        ThreadPoolWorker *victim = &pool->workers[(start + i) % (unsigned)pool->nthreads];
+
+        if (victim != self) {
+            found = ThreadPoolWorker_take(victim, &task, 1);
+        }
+    }
+
+    if (!found) {
+        return 0;
+    }
+
+    atomic_fetch_sub(&pool->queued, 1);
+    task.fn(task.arg);
+
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->idle);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return 1;
+}
+
+static void *ThreadPool_worker(void *arg)
+{
+    ThreadPoolWorker *worker = arg;
+    ThreadPool *pool = worker->pool;
+    int done = 0;
+
+    ThreadPool_current = worker;
+
+    while (!done) {
+        if (ThreadPool_run_one(pool)) {
+            continue;
+        }
+
+        /*
+         * sleeping goes up before queued is looked at, and submit bumps
+         * queued before it looks at sleeping, so one of the two always
+         * sees the other and a task is never left with everyone asleep.
+         */
+        pthread_mutex_lock(&pool->lock);
+        atomic_fetch_add(&pool->sleeping, 1);
+
+        while (atomic_load(&pool->queued) <= 0 && !pool->stopping) {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+
+        atomic_fetch_sub(&pool->sleeping, 1);
+        done = pool->stopping && atomic_load(&pool->queued) <= 0;
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    ThreadPool_current = NULL;
+    return NULL;
+}
+
+// stops and joins the first nstarted workers, then frees everything
+static void ThreadPool_stop(ThreadPool * pool, int nstarted)
+{
+    int i = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = 1;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < nstarted; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (i = 0; i < pool->nthreads; i++) {
+        pthread_mutex_destroy(&pool->workers[i].lock);
+        free(pool->workers[i].tasks);
+    }
+
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->workers);
+    free(pool);
+}
+
+ThreadPool *ThreadPool_create(int nthreads)
+{
+    ThreadPool *pool = NULL;
+    int i = 0;
+
+    check(nthreads > 0, "Need at least one thread, got %d.", nthreads);
+
+    pool = calloc(1, sizeof(ThreadPool));
+    check_mem(pool);
+
+    pool->workers = calloc(nthreads, sizeof(ThreadPoolWorker));
+    check_mem(pool->workers);
+
+    pool->nthreads = nthreads;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+
+    for (i = 0; i < nthreads; i++) {
+        pthread_mutex_init(&pool->workers[i].lock, NULL);
+        pool->workers[i].pool = pool;
+    }
+
+    for (i = 0; i < nthreads; i++) {
+        if (pthread_create(&pool->workers[i].thread, NULL, ThreadPool_worker,
+                    &pool->workers[i]) != 0) {
+            ThreadPool_stop(pool, i);
+            pool = NULL;
+            sentinel("Failed to start worker %d of %d.", i, nthreads);
+        }
+    }
+
+    return pool;
+
+error:
+    if (pool != NULL) {
+        free(pool->workers);
+        free(pool);
+    }
+    return NULL;
+}
+
+void ThreadPool_destroy(ThreadPool * pool)
+{
+    if (pool) {
+        ThreadPool_wait(pool);
+        ThreadPool_stop(pool, pool->nthreads);
+    }
+}
+
+int ThreadPool_submit(ThreadPool * pool, ThreadPool_task fn, void *arg)
+{
+    ThreadPoolTask task = { fn, arg };
+    ThreadPoolWorker *worker = ThreadPool_self(pool);
+
+    if (worker == NULL) {
+        worker = &pool->workers[atomic_fetch_add(&pool->next, 1) %
+            (unsigned)pool->nthreads];
+    }
+
+    atomic_fetch_add(&pool->pending, 1);
+    atomic_fetch_add(&pool->queued, 1);
+
+    if (ThreadPoolWorker_push(worker, task) != 0) {
+        atomic_fetch_sub(&pool->queued, 1);
+        atomic_fetch_sub(&pool->pending, 1);
+        return -1;
+    }
+
+    // no lock or syscall at all while every worker is busy
+    if (atomic_load(&pool->sleeping) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_signal(&pool->work);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return 0;
+}
+
+void ThreadPool_wait(ThreadPool * pool)
+{
+    pthread_mutex_lock(&pool->lock);
+
+    while (atomic_load(&pool->pending) > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,68 @@
+#ifndef lcthw_ThreadPool_h
+#define lcthw_ThreadPool_h
+
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+/*
+ * Fixed set of worker threads, each with its own deque of tasks. A
+ * worker takes from the back of its own deque and, when that's empty,
+ * steals from the front of the others, so one slow task doesn't leave
+ * the rest of its worker's queue waiting. Tasks submitted from inside a
+ * task go on that worker's deque, the rest are dealt out round robin.
+ */
+
+typedef void (*ThreadPool_task) (void *arg);
+
+typedef struct ThreadPoolTask {
+    ThreadPool_task fn;
+    void *arg;
+} ThreadPoolTask;
+
+struct ThreadPool;
+
+typedef struct ThreadPoolWorker {
+    // ring buffer, the owner works at tail and thieves at head
+    pthread_mutex_t lock;
+    ThreadPoolTask *tasks;
+    int head;
+    int count;
+    int capacity;
+    pthread_t thread;
+    struct ThreadPool *pool;
+} ThreadPoolWorker;
+
+typedef struct ThreadPool {
+    int nthreads;
+    ThreadPoolWorker *workers;
+    // queued is what's sitting in deques, pending also counts running tasks
+    atomic_int queued;
+    atomic_int pending;
+    atomic_int sleeping;
+    atomic_uint next;
+    int stopping;
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t idle;
+} ThreadPool;
+
+ThreadPool *ThreadPool_create(int nthreads);
+// finishes every submitted task before the threads stop
+void ThreadPool_destroy(ThreadPool * pool);
+
+#define ThreadPool_threads(A) ((A)->nthreads)
+
+int ThreadPool_submit(ThreadPool * pool, ThreadPool_task fn, void *arg);
+
+// blocks until every task is done, don't call it from a task
+void ThreadPool_wait(ThreadPool * pool);
+
+/*
+ * Takes one queued task, its own deque first if the caller is a worker,
+ * and runs it on the calling thread. 0 if there was nothing to take.
+ * Lets a thread that waits on its own tasks help instead of blocking.
+ */
+int ThreadPool_run_one(ThreadPool * pool);
+
+#endif
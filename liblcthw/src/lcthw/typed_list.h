@@ -0,0 +1,154 @@
+#ifndef lcthw_Typed_list_h
+#define lcthw_Typed_list_h
+
+#include <stdlib.h>
+#include <string.h>
+#include <lcthw/list_sort.h>
+
+/*
+ * Lists that keep the value in the node instead of a void * to it, so
+ * an int or a small struct costs one node and no separate allocation:
+ *
+ *     DEFINE_TYPED_LIST(IntList, int)
+ *     DEFINE_TYPED_LIST_SORT(IntList, IntList_sort, LIST_CMP_INT)
+ *     ...
+ *     IntList *list = IntList_create();
+ *     IntList_push(list, 42);
+ *     IntList_sort(list);
+ *     TYPED_LIST_FOREACH(IntList, list, first, next, cur) {
+ *         total += cur->value;
+ *     }
+ *
+ * That makes IntList and IntListNode, plus IntList_create, _destroy,
+ * _push, _pop, _unshift, _shift and _remove, all static inline. pop,
+ * shift and remove hand the value back by copy, and give a zeroed T
+ * on an empty list. CMP gets two T * like the LIST_CMP_ macros do.
+ */
+
+#define DEFINE_TYPED_LIST(name, T)\
+typedef struct name##Node {\
+    struct name##Node *next;\
+    struct name##Node *prev;\
+    T value;\
+} name##Node;\
+\
+typedef struct name {\
+    int count;\
+    name##Node *first;\
+    name##Node *last;\
+} name;\
+\
+static inline name *name##_create()\
+{\
+    return calloc(1, sizeof(name));\
+}\
+\
+static inline void name##_destroy(name *list)\
+{\
+    name##Node *node = list->first;\
+\
+    while (node != NULL) {\
+        name##Node *next = node->next;\
+        free(node);\
+        node = next;\
+    }\
+\
+    free(list);\
+}\
+\
+static inline int name##_push(name *list, T value)\
+{\
+    name##Node *node = malloc(sizeof(name##Node));\
+    if (node == NULL) return -1;\
+\
+    node->value = value;\
+    node->next = NULL;\
+    node->prev = list->last;\
+\
+    if (list->last == NULL) {\
+        list->first = node;\
+    } else {\
+        list->last->next = node;\
+    }\
+\
+    list->last = node;\
+    list->count++;\
+    return 0;\
+}\
+\
+static inline int name##_unshift(name *list, T value)\
+{\
+    name##Node *node = malloc(sizeof(name##Node));\
+    if (node == NULL) return -1;\
+\
+    node->value = value;\
+    node->prev = NULL;\
+    node->next = list->first;\
+\
+    if (list->first == NULL) {\
+        list->last = node;\
+    } else {\
+        list->first->prev = node;\
+    }\
+\
+    list->first = node;\
+    list->count++;\
+    return 0;\
+}\
+\
+static inline T name##_remove(name *list, name##Node *node)\
+{\
+    T value = node->value;\
+\
+    if (node->prev == NULL) {\
+        list->first = node->next;\
+    } else {\
+        node->prev->next = node->next;\
+    }\
+\
+    if (node->next == NULL) {\
+        list->last = node->prev;\
+    } else {\
+        node->next->prev = node->prev;\
+    }\
+\
+    list->count--;\
+    free(node);\
+    return value;\
+}\
+\
+static inline T name##_pop(name *list)\
+{\
+    T value;\
+\
+    if (list->last != NULL) {\
+        return name##_remove(list, list->last);\
+    }\
+\
+    memset(&value, 0, sizeof(T));\
+    return value;\
+}\
+\
+static inline T name##_shift(name *list)\
+{\
+    T value;\
+\
+    if (list->first != NULL) {\
+        return name##_remove(list, list->first);\
+    }\
+\
+    memset(&value, 0, sizeof(T));\
+    return value;\
+}
+
+#define TYPED_LIST_VALUE(N, T) (&(N)->value)
+
+// the in-place merge sort from list_sort.h, comparing the values in the nodes
+#define DEFINE_TYPED_LIST_SORT(name, sort_name, CMP)\
+    LIST_DEFINE_NODE_SORT(sort_name, name, name##Node, void, TYPED_LIST_VALUE, CMP)
+
+#define TYPED_LIST_FOREACH(name, L, S, M, V) name##Node *_tnode = NULL;\
+                                                          name##Node *V = NULL;\
+for(V = _tnode = L->S; _tnode != NULL; V = _tnode = _tnode->M)
+
+#endif
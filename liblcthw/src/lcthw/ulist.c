@@ -0,0 +1,267 @@
+#include <lcthw/ulist.h>
+#include <lcthw/dbg.h>
+
+UList *UList_create()
+{
+    return calloc(1, sizeof(UList));
+}
+
+void UList_destroy(UList * list)
+{
+    UListChunk *chunk = list->first;
+
+    while (chunk != NULL) {
+        UListChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(list);
+}
+
+void UList_clear(UList * list)
+{
+    ULIST_FOREACH(list, chunk, i) {
+        free(chunk->values[i]);
+    }
+}
+
+void UList_clear_destroy(UList * list)
+{
+    UList_clear(list);
+    UList_destroy(list);
+}
+
+static UListChunk *UList_add_chunk(UList * list, UListChunk * after)
+{
+    UListChunk *chunk = calloc(1, sizeof(UListChunk));
+    check_mem(chunk);
+
+    if (after == NULL) {
+        chunk->next = list->first;
+        if (list->first != NULL) {
+            list->first->prev = chunk;
+        }
+        list->first = chunk;
+    } else {
+        chunk->prev = after;
+        chunk->next = after->next;
+        if (after->next != NULL) {
+            after->next->prev = chunk;
+        }
+        after->next = chunk;
+    }
+
+    if (chunk->next == NULL) {
+        list->last = chunk;
+    }
+
+error:          // fallthrough
+    return chunk;
+}
+
+static void UList_remove_chunk(UList * list, UListChunk * chunk)
+{
+    if (chunk->prev != NULL) {
+        chunk->prev->next = chunk->next;
+    } else {
+        list->first = chunk->next;
+    }
+
+    if (chunk->next != NULL) {
+        chunk->next->prev = chunk->prev;
+    } else {
+        list->last = chunk->prev;
+    }
+
+    free(chunk);
+}
+
+void UList_push(UList * list, void *value)
+{
+    UListChunk *chunk = list->last;
+
+    if (chunk == NULL || chunk->count == ULIST_CHUNK) {
+        chunk = UList_add_chunk(list, list->last);
+        check(chunk != NULL, "Failed to add a chunk.");
+    }
+
+    chunk->values[chunk->count++] = value;
+    list->count++;
+
+error:
+    return;
+}
+
+void *UList_pop(UList * list)
+{
+    UListChunk *chunk = list->last;
+    return chunk != NULL ? UList_remove(list, chunk, chunk->count - 1) : NULL;
+}
+
+void UList_unshift(UList * list, void *value)
+{
+    UListChunk *chunk = list->first;
+
+    if (chunk == NULL || chunk->count == ULIST_CHUNK) {
+        chunk = UList_add_chunk(list, NULL);
+        check(chunk != NULL, "Failed to add a chunk.");
+    }
+
+    memmove(&chunk->values[1], &chunk->values[0],
+            chunk->count * sizeof(void *));
+    chunk->values[0] = value;
+    chunk->count++;
+    list->count++;
+
+error:
+    return;
+}
+
+void *UList_shift(UList * list)
+{
+    UListChunk *chunk = list->first;
+    return chunk != NULL ? UList_remove(list, chunk, 0) : NULL;
+}
+
+/*
+ * Moves next's values onto the end of chunk and frees next, if they fit.
+ * Keeps chunks at least half full, instead of left with a value or two
+ * each after a lot of removes.
+ */
+static void UList_merge_chunks(UList * list, UListChunk * chunk,
+        UListChunk * next)
+{
+    if (chunk == NULL || next == NULL ||
+            chunk->count + next->count > ULIST_CHUNK) {
+        return;
+    }
+
+    memcpy(&chunk->values[chunk->count], &next->values[0],
+            next->count * sizeof(void *));
+    chunk->count += next->count;
+    UList_remove_chunk(list, next);
+}
+
+void *UList_remove(UList * list, UListChunk * chunk, int index)
+{
+    void *result = NULL;
+
+    check(list->first && list->last, "List is empty.");
+    check(chunk, "chunk can't be NULL");
+    check(index >= 0 && index < chunk->count, "Invalid index %d.", index);
+
+    result = chunk->values[index];
+    chunk->count--;
+    memmove(&chunk->values[index], &chunk->values[index + 1],
+            (chunk->count - index) * sizeof(void *));
+    list->count--;
+
+    if (chunk->count == 0) {
+        UList_remove_chunk(list, chunk);
+    } else if (chunk->count < ULIST_CHUNK / 2) {
+        if (chunk->next != NULL &&
+                chunk->count + chunk->next->count <= ULIST_CHUNK) {
+            UList_merge_chunks(list, chunk, chunk->next);
+        } else {
+            UList_merge_chunks(list, chunk->prev, chunk);
+        }
+    }
+
+error:
+    return result;
+}
+
+int UList_bubble_sort(UList * list, List_compare cmp)
+{
+    int sorted = 1;
+
+    if (UList_count(list) <= 1) {
+        return 0;   // already sorted
+    }
+
+    do {
+        void **prev = NULL;
+        sorted = 1;
+
+        ULIST_FOREACH(list, chunk, i) {
+            void **cur = &chunk->values[i];
+
+            if (prev != NULL && cmp(*prev, *cur) > 0) {
+                void *temp = *prev;
+                *prev = *cur;
+                *cur = temp;
+                sorted = 0;
+            }
+
+            prev = cur;
+        }
+    } while (!sorted);
+
+    return 0;
+}
+
+/*
+ * Values are copied out to an array, merge sorted bottom-up between its
+ * two halves, then copied back. One allocation for the whole sort, and
+ * it's stable.
+ */
+int UList_merge_sort(UList * list, List_compare cmp)
+{
+    int n = UList_count(list);
+    void **values = NULL;
+    void **from = NULL;
+    void **to = NULL;
+    int width = 0;
+    int i = 0;
+
+    if (n <= 1) {
+        return 0;
+    }
+
+    values = malloc(2 * (size_t)n * sizeof(void *));
+    check_mem(values);
+
+    from = values;
+    to = values + n;
+
+    ULIST_FOREACH(list, chunk, j) {
+        from[i++] = chunk->values[j];
+    }
+
+    for (width = 1; width < n; width *= 2) {
+        for (i = 0; i < n; i += 2 * width) {
+            int left = i;
+            int mid = i + width < n ? i + width : n;
+            int end = i + 2 * width < n ? i + 2 * width : n;
+            int right = mid;
+            int k = i;
+
+            while (left < mid && right < end) {
+                if (cmp(from[left], from[right]) <= 0) {
+                    to[k++] = from[left++];
+                } else {
+                    to[k++] = from[right++];
+                }
+            }
+
+            while (left < mid) to[k++] = from[left++];
+            while (right < end) to[k++] = from[right++];
+        }
+
+        void **temp = from;
+        from = to;
+        to = temp;
+    }
+
+    i = 0;
+    ULIST_FOREACH(list, chunk, j) {
+        chunk->values[j] = from[i++];
+    }
+
+    free(values);
+    return 0;
+
+error:
+    return -1;
+}
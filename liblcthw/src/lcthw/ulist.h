@@ -0,0 +1,56 @@
+#ifndef lcthw_UList_h
+#define lcthw_UList_h
+
+#include <stdlib.h>
+#include <lcthw/list_algos.h>
+
+// values per chunk, fixed since it's baked into the library's layout
+#define ULIST_CHUNK 16
+
+struct UListChunk;
+
+typedef struct UListChunk {
+    struct UListChunk *next;
+    struct UListChunk *prev;
+    int count;
+    void *values[ULIST_CHUNK];
+} UListChunk;
+
+typedef struct UList {
+    int count;
+    UListChunk *first;
+    UListChunk *last;
+} UList;
+
+UList *UList_create();
+void UList_destroy(UList * list);
+void UList_clear(UList * list);
+void UList_clear_destroy(UList * list);
+
+#define UList_count(A) ((A)->count)
+#define UList_first(A) ((A)->first != NULL ? (A)->first->values[0] : NULL)
+#define UList_last(A) ((A)->last != NULL ?\
+        (A)->last->values[(A)->last->count - 1] : NULL)
+
+void UList_push(UList * list, void *value);
+void *UList_pop(UList * list);
+
+void UList_unshift(UList * list, void *value);
+void *UList_shift(UList * list);
+
+/*
+ * Removes the value at index in chunk. A chunk that's left less than
+ * half full is merged with a neighbour when they fit in one, so chunk
+ * and the chunks next to it may be freed.
+ */
+void *UList_remove(UList * list, UListChunk * chunk, int index);
+
+int UList_bubble_sort(UList * list, List_compare cmp);
+int UList_merge_sort(UList * list, List_compare cmp);
+
+// C->values[I] is the current value, don't remove while iterating
+#define ULIST_FOREACH(L, C, I) \
+    for (UListChunk *C = (L)->first; C != NULL; C = C->next)\
+        for (int I = 0; I < C->count; I++)
+
+#endif
@@ -0,0 +1,142 @@
+#include "minunit.h"
+#include <lcthw/clist.h>
+#include <assert.h>
+
+static CList *list = NULL;
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_create()
+{
+    list = CList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+    mu_assert(CList_first(list) == NULL, "New list should be empty.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    CList_destroy(list);
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    CList_push(list, test1);
+    mu_assert(CList_last(list) == test1, "Wrong last value.");
+
+    CList_push(list, test2);
+    mu_assert(CList_last(list) == test2, "Wrong last value.");
+
+    CList_push(list, test3);
+    mu_assert(CList_last(list) == test3, "Wrong last value.");
+    mu_assert(CList_count(list) == 3, "Wrong count on push.");
+
+    char *val = CList_pop(list);
+    mu_assert(val == test3, "Wrong value on pop.");
+
+    val = CList_pop(list);
+    mu_assert(val == test2, "Wrong value on pop.");
+
+    val = CList_pop(list);
+    mu_assert(val == test1, "Wrong value on pop.");
+    mu_assert(CList_count(list) == 0, "Wrong count after pop.");
+    mu_assert(CList_pop(list) == NULL, "Pop of empty should be NULL.");
+
+    return NULL;
+}
+
+char *test_unshift_shift()
+{
+    CList_unshift(list, test1);
+    mu_assert(CList_first(list) == test1, "Wrong first value.");
+
+    CList_unshift(list, test2);
+    mu_assert(CList_first(list) == test2, "Wrong first value.");
+
+    CList_unshift(list, test3);
+    mu_assert(CList_first(list) == test3, "Wrong first value.");
+    mu_assert(CList_count(list) == 3, "Wrong count on unshift.");
+
+    mu_assert(CList_shift(list) == test3, "Wrong value on shift.");
+    mu_assert(CList_shift(list) == test2, "Wrong value on shift.");
+    mu_assert(CList_shift(list) == test1, "Wrong value on shift.");
+    mu_assert(CList_count(list) == 0, "Wrong count after shift.");
+
+    return NULL;
+}
+
+char *test_remove()
+{
+    CList_push(list, test1);
+    uint32_t middle = CList_push(list, test2);
+    CList_push(list, test3);
+
+    mu_assert(CList_remove(list, middle) == test2, "Wrong removed element.");
+    mu_assert(CList_count(list) == 2, "Wrong count after remove.");
+    mu_assert(CList_first(list) == test1, "Wrong first after remove.");
+    mu_assert(CList_last(list) == test3, "Wrong last after remove.");
+
+    mu_assert(CList_remove(list, middle) == NULL, "Removed a slot twice.");
+    mu_assert(CList_remove(list, 9999) == NULL, "Removed past the end.");
+
+    // the freed slot is the next one handed out
+    mu_assert(CList_push(list, test2) == middle, "Free slot wasn't reused.");
+
+    return NULL;
+}
+
+char *test_many_and_copy()
+{
+    static int values[1000];
+    int i = 0;
+
+    CList *many = CList_create();
+    for (i = 0; i < 1000; i++) {
+        values[i] = i;
+        if (i % 2) CList_push(many, &values[i]);
+        else CList_unshift(many, &values[i]);
+    }
+    mu_assert(CList_count(many) == 1000, "Wrong count after growing.");
+
+    CList *copy = CList_copy(many);
+    mu_assert(copy != NULL, "Copy failed.");
+    CList_destroy(many);
+
+    // evens count down to 0, then the odds count up
+    int expect = 998;
+    int seen = 0;
+    CLIST_FOREACH(copy, first, next, cur) {
+        mu_assert(*(int *)cur->value == expect, "Copy out of order.");
+        expect = expect == 0 ? 1 : expect % 2 ? expect + 2 : expect - 2;
+        seen++;
+    }
+    mu_assert(seen == 1000, "Copy lost nodes.");
+
+    // and the copy keeps working on its own
+    mu_assert(CList_pop(copy) == &values[999], "Wrong pop from the copy.");
+    mu_assert(CList_push(copy, &values[0]) != CLIST_NIL, "Push on copy failed.");
+    mu_assert(CList_last(copy) == &values[0], "Wrong last on the copy.");
+
+    CList_destroy(copy);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift_shift);
+    mu_run_test(test_remove);
+    mu_run_test(test_destroy);
+    mu_run_test(test_many_and_copy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
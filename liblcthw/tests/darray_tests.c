@@ -0,0 +1,249 @@
+#include "minunit.h"
+#include <lcthw/darray.h>
+
+static DArray *array = NULL;
+static int *val1 = NULL;
+static int *val2 = NULL;
+
+char *test_create()
+{
+    array = DArray_create(sizeof(int), 100);
+    mu_assert(array != NULL, "DArray_create failed.");
+    mu_assert(array->contents != NULL, "contents are wrong in darray");
+    mu_assert(array->end == 0, "end isn't at the right spot");
+    mu_assert(array->element_size == sizeof(int),
+            "element size is wrong.");
+    mu_assert(array->max == 100, "wrong max length on initial size");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    DArray_destroy(array);
+
+    return NULL;
+}
+
+char *test_new()
+{
+    val1 = DArray_new(array);
+    mu_assert(val1 != NULL, "failed to make a new element");
+
+    val2 = DArray_new(array);
+    mu_assert(val2 != NULL, "failed to make a new element");
+
+    return NULL;
+}
+
+char *test_set()
+{
+    DArray_set(array, 0, val1);
+    DArray_set(array, 1, val2);
+
+    return NULL;
+}
+
+char *test_get()
+{
+    mu_assert(DArray_get(array, 0) == val1, "Wrong first value.");
+    mu_assert(DArray_get(array, 1) == val2, "Wrong second value.");
+
+    return NULL;
+}
+
+char *test_remove()
+{
+    int *val_check = DArray_remove(array, 0);
+    mu_assert(val_check != NULL, "Should not get NULL.");
+    mu_assert(*val_check == *val1, "Should get the first value.");
+    mu_assert(DArray_get(array, 0) == NULL, "Should be gone.");
+    DArray_free(val_check);
+
+    val_check = DArray_remove(array, 1);
+    mu_assert(val_check != NULL, "Should not get NULL.");
+    mu_assert(*val_check == *val2, "Should get the second value.");
+    mu_assert(DArray_get(array, 1) == NULL, "Should be gone.");
+    DArray_free(val_check);
+
+    return NULL;
+}
+
+char *test_expand_shrink()
+{
+    int old_max = array->max;
+    DArray_expand(array, 0);
+    mu_assert((unsigned int)array->max >= old_max + array->expand_rate,
+            "Wrong size after expand.");
+
+    array->end = 10;
+    DArray_shrink_to_fit(array);
+    mu_assert(array->max == 10, "Should shrink to the element count.");
+
+    array->end = 0;
+    DArray_shrink_to_fit(array);
+    mu_assert(array->max == 1, "Should stay at least 1.");
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    int i = 0;
+    for (i = 0; i < 1000; i++) {
+        int *val = DArray_new(array);
+        *val = i * 333;
+        DArray_push(array, val);
+    }
+
+    mu_assert(array->max >= 1000, "Wrong max size.");
+
+    for (i = 999; i >= 0; i--) {
+        int *val = DArray_pop(array);
+        mu_assert(val != NULL, "Shouldn't get a NULL.");
+        mu_assert(*val == i * 333, "Wrong value.");
+        DArray_free(val);
+    }
+
+    mu_assert(DArray_pop(array) == NULL, "Pop of empty should be NULL.");
+
+    return NULL;
+}
+
+typedef struct Point {
+    int x;
+    int y;
+} Point;
+
+int cmp_point(const Point * a, const Point * b)
+{
+    return a->x - b->x;
+}
+
+int cmp_int(const int *a, const int *b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+char *test_inline()
+{
+    DArray *points = DArray_create_inline(sizeof(Point), 2);
+    Point p = { 0, 0 };
+    int i = 0;
+
+    mu_assert(points != NULL, "Failed to create inline darray.");
+
+    for (i = 0; i < 500; i++) {
+        p.x = (i * 7919) % 503;
+        p.y = i;
+        mu_assert(DArray_push(points, &p) == 0, "Inline push failed.");
+    }
+
+    Point *last = DArray_last(points);
+    mu_assert(last->y == 499, "Inline push didn't copy the element.");
+
+    DArray_qsort(points, (List_compare) cmp_point);
+    for (i = 1; i < DArray_count(points); i++) {
+        Point *a = DArray_get(points, i - 1);
+        Point *b = DArray_get(points, i);
+        mu_assert(a->x <= b->x, "Inline qsort didn't sort.");
+    }
+
+    Point *popped = DArray_pop(points);
+    mu_assert(popped->x == 502 || popped->x == 501,
+            "Inline pop gave the wrong element.");
+    mu_assert(DArray_count(points) == 499, "Wrong count after inline pop.");
+
+    // inline arrays own nothing, so this must not free the elements
+    DArray_clear_destroy(points);
+    return NULL;
+}
+
+static char *check_sort(int (*sort) (DArray *, List_compare), int n,
+        int pattern)
+{
+    DArray *ints = DArray_create(sizeof(int), 1);
+    int *values = malloc(n * sizeof(int));
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        values[i] = pattern == 0 ? (i * 7919) % 1013 :
+            pattern == 1 ? i : pattern == 2 ? n - i : 5;
+        DArray_push(ints, &values[i]);
+    }
+
+    mu_assert(sort(ints, (List_compare) cmp_int) == 0, "Sort failed.");
+    for (i = 1; i < n; i++) {
+        mu_assert(*(int *)DArray_get(ints, i - 1) <=
+                *(int *)DArray_get(ints, i), "Not sorted.");
+    }
+
+    DArray_destroy(ints);
+    free(values);
+    return NULL;
+}
+
+char *test_sorts()
+{
+    int pattern = 0;
+    char *msg = NULL;
+
+    for (pattern = 0; pattern < 4; pattern++) {
+        msg = check_sort(DArray_qsort, 5000, pattern);
+        if (msg) return msg;
+        msg = check_sort(DArray_heapsort, 5000, pattern);
+        if (msg) return msg;
+        msg = check_sort(DArray_qsort, 3, pattern);
+        if (msg) return msg;
+    }
+
+    return NULL;
+}
+
+char *test_list_conversion()
+{
+    char *words[] = { "one", "two", "three" };
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 3; i++) {
+        List_push(list, words[i]);
+    }
+
+    DArray *from_list = List_to_darray(list);
+    mu_assert(DArray_count(from_list) == 3, "Wrong count from list.");
+    mu_assert(DArray_max(from_list) == 3, "Should size exactly.");
+    mu_assert(DArray_get(from_list, 2) == words[2], "Wrong order from list.");
+
+    List *back = DArray_to_list(from_list);
+    mu_assert(List_count(back) == 3, "Wrong count back to list.");
+    mu_assert(List_first(back) == words[0], "Wrong first back to list.");
+    mu_assert(List_last(back) == words[2], "Wrong last back to list.");
+
+    List_destroy(back);
+    DArray_destroy(from_list);
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_new);
+    mu_run_test(test_set);
+    mu_run_test(test_get);
+    mu_run_test(test_remove);
+    mu_run_test(test_expand_shrink);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_destroy);
+    mu_run_test(test_inline);
+    mu_run_test(test_sorts);
+    mu_run_test(test_list_conversion);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,193 @@
+#include "minunit.h"
+#include <lcthw/hashmap.h>
+#include <assert.h>
+
+#define MANY 20000
+
+static Hashmap *map = NULL;
+static int traverse_called = 0;
+static char keys[MANY][16];
+
+char *test1 = "test data 1";
+char *test2 = "test data 2";
+char *test3 = "xest data 3";
+char *expect1 = "THE VALUE 1";
+char *expect2 = "THE VALUE 2";
+char *expect3 = "THE VALUE 3";
+
+static int traverse_good_cb(HashmapEntry * entry)
+{
+    debug("KEY: %s", (char *)entry->key);
+    traverse_called++;
+    return 0;
+}
+
+static int traverse_fail_cb(HashmapEntry * entry)
+{
+    debug("KEY: %s", (char *)entry->key);
+    traverse_called++;
+
+    return traverse_called == 2 ? 1 : 0;
+}
+
+// every key collides, so all the work is in the probing
+static uint32_t bad_hash(const void *key)
+{
+    (void)key;
+    return 7;
+}
+
+char *test_create()
+{
+    map = Hashmap_create(NULL, NULL);
+    mu_assert(map != NULL, "Failed to create map.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    Hashmap_destroy(map);
+
+    return NULL;
+}
+
+char *test_get_set()
+{
+    int rc = Hashmap_set(map, test1, expect1);
+    mu_assert(rc == 0, "Failed to set test1");
+    mu_assert(Hashmap_get(map, test1) == expect1, "Wrong value for test1.");
+
+    rc = Hashmap_set(map, test2, expect2);
+    mu_assert(rc == 0, "Failed to set test2");
+    mu_assert(Hashmap_get(map, test2) == expect2, "Wrong value for test2.");
+
+    rc = Hashmap_set(map, test3, expect3);
+    mu_assert(rc == 0, "Failed to set test3");
+    mu_assert(Hashmap_get(map, test3) == expect3, "Wrong value for test3.");
+
+    // setting again replaces, a copy of the key has to match too
+    char copy[] = "test data 1";
+    rc = Hashmap_set(map, copy, expect2);
+    mu_assert(rc == 0, "Failed to set test1 again");
+    mu_assert(Hashmap_get(map, test1) == expect2, "test1 not replaced.");
+    mu_assert(Hashmap_count(map) == 3, "Replacing changed the count.");
+    Hashmap_set(map, test1, expect1);
+
+    mu_assert(Hashmap_get(map, "not there") == NULL, "Found a missing key.");
+
+    return NULL;
+}
+
+char *test_traverse()
+{
+    int rc = Hashmap_traverse(map, traverse_good_cb);
+    mu_assert(rc == 0, "Failed to traverse.");
+    mu_assert(traverse_called == 3, "Wrong count traverse.");
+
+    traverse_called = 0;
+    rc = Hashmap_traverse(map, traverse_fail_cb);
+    mu_assert(rc == 1, "Failed to traverse.");
+    mu_assert(traverse_called == 2, "Wrong count traverse for fail.");
+
+    return NULL;
+}
+
+char *test_delete()
+{
+    char *deleted = Hashmap_delete(map, test1);
+    mu_assert(deleted != NULL, "Got NULL on delete.");
+    mu_assert(deleted == expect1, "Should get test1");
+    mu_assert(Hashmap_get(map, test1) == NULL, "Should delete.");
+
+    deleted = Hashmap_delete(map, test2);
+    mu_assert(deleted == expect2, "Should get test2");
+    mu_assert(Hashmap_get(map, test2) == NULL, "Should delete.");
+
+    deleted = Hashmap_delete(map, test3);
+    mu_assert(deleted == expect3, "Should get test3");
+    mu_assert(Hashmap_get(map, test3) == NULL, "Should delete.");
+
+    mu_assert(Hashmap_delete(map, test3) == NULL, "Deleted twice.");
+    mu_assert(Hashmap_count(map) == 0, "Wrong count after delete.");
+
+    return NULL;
+}
+
+char *test_many()
+{
+    Hashmap *m = Hashmap_create(NULL, NULL);
+    HashmapIter iter;
+    HashmapEntry *entry = NULL;
+    int i = 0;
+
+    for (i = 0; i < MANY; i++) {
+        snprintf(keys[i], 16, "key%d", i);
+        mu_assert(Hashmap_set(m, keys[i], keys[i]) == 0, "Set failed.");
+
+        // deletes in the middle of resizes hit both tables
+        if (i % 2 == 1) {
+            mu_assert(Hashmap_delete(m, keys[i / 2]) == keys[i / 2],
+                    "Delete during resize failed.");
+        }
+    }
+
+    // the first half is gone, the second half is still there
+    for (i = 0; i < MANY; i++) {
+        void *expect = i < MANY / 2 ? NULL : keys[i];
+        mu_assert(Hashmap_get(m, keys[i]) == expect,
+                "Wrong value after resizes.");
+    }
+    mu_assert(Hashmap_count(m) == MANY / 2, "Wrong count after resizes.");
+
+    int seen = 0;
+    Hashmap_iter_init(m, &iter);
+    while ((entry = Hashmap_iter_next(&iter)) != NULL) {
+        mu_assert(Hashmap_get(m, entry->key) == entry->data,
+                "Iterator gave an entry get can't find.");
+        seen++;
+    }
+    mu_assert(seen == MANY / 2, "Iterator missed or repeated entries.");
+
+    Hashmap_destroy(m);
+    return NULL;
+}
+
+char *test_collisions()
+{
+    Hashmap *m = Hashmap_create(NULL, bad_hash);
+    int i = 0;
+
+    for (i = 0; i < 300; i++) {
+        snprintf(keys[i], 16, "key%d", i);
+        Hashmap_set(m, keys[i], keys[i]);
+    }
+    for (i = 0; i < 300; i += 2) {
+        mu_assert(Hashmap_delete(m, keys[i]) == keys[i], "Delete failed.");
+    }
+    for (i = 0; i < 300; i++) {
+        void *expect = i % 2 ? keys[i] : NULL;
+        mu_assert(Hashmap_get(m, keys[i]) == expect,
+                "Wrong lookup with colliding keys.");
+    }
+
+    Hashmap_destroy(m);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_get_set);
+    mu_run_test(test_traverse);
+    mu_run_test(test_delete);
+    mu_run_test(test_destroy);
+    mu_run_test(test_many);
+    mu_run_test(test_collisions);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,130 @@
+#include "minunit.h"
+#include <lcthw/ilist.h>
+#include <assert.h>
+
+typedef struct Conn {
+    int fd;
+    IListNode link;
+} Conn;
+
+static IList *list = NULL;
+static Conn conns[3] = { {.fd = 1}, {.fd = 2}, {.fd = 3} };
+
+#define fd_of(N) (IList_entry((N), Conn, link)->fd)
+
+char *test_create()
+{
+    list = IList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    IList_destroy(list);
+
+    return NULL;
+}
+
+char *test_entry()
+{
+    mu_assert(IList_entry(&conns[1].link, Conn, link) == &conns[1],
+            "IList_entry got the wrong struct.");
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    IList_push(list, &conns[0].link);
+    IList_push(list, &conns[1].link);
+    IList_push(list, &conns[2].link);
+    mu_assert(IList_count(list) == 3, "Wrong count on push.");
+    mu_assert(fd_of(IList_last(list)) == 3, "Wrong last value.");
+
+    mu_assert(fd_of(IList_pop(list)) == 3, "Wrong value on pop.");
+    mu_assert(fd_of(IList_pop(list)) == 2, "Wrong value on pop.");
+    mu_assert(fd_of(IList_pop(list)) == 1, "Wrong value on pop.");
+    mu_assert(IList_pop(list) == NULL, "Pop of empty should be NULL.");
+    mu_assert(IList_count(list) == 0, "Wrong count after pop.");
+
+    return NULL;
+}
+
+char *test_unshift_shift()
+{
+    IList_unshift(list, &conns[0].link);
+    IList_unshift(list, &conns[1].link);
+    IList_unshift(list, &conns[2].link);
+    mu_assert(fd_of(IList_first(list)) == 3, "Wrong first value.");
+
+    int expect = 3;
+    ILIST_FOREACH(list, first, next, cur) {
+        mu_assert(fd_of(cur) == expect, "Wrong iteration order.");
+        expect--;
+    }
+
+    mu_assert(fd_of(IList_shift(list)) == 3, "Wrong value on shift.");
+    mu_assert(IList_count(list) == 2, "Wrong count after shift.");
+
+    return NULL;
+}
+
+char *test_remove()
+{
+    // list is 2, 1 now, pull an element out by itself
+    IListNode *node = IList_remove(list, &conns[1].link);
+    mu_assert(node == &conns[1].link, "Wrong removed element.");
+    mu_assert(node->next == NULL && node->prev == NULL,
+            "Removed node still has links.");
+    mu_assert(IList_count(list) == 1, "Wrong count after remove.");
+    mu_assert(fd_of(IList_first(list)) == 1, "Wrong first after remove.");
+    mu_assert(IList_first(list) == IList_last(list), "Wrong last after remove.");
+
+    // a node that was removed can go straight back on
+    IList_push(list, node);
+    IList_push(list, &conns[2].link);
+    IList_remove(list, node);
+    mu_assert(conns[0].link.next == &conns[2].link, "Middle remove broke next.");
+    mu_assert(conns[2].link.prev == &conns[0].link, "Middle remove broke prev.");
+
+    mu_assert(IList_remove(list, &conns[1].link) == NULL,
+            "Should not remove a node that isn't on the list.");
+
+    // the tail of another list mustn't touch either list
+    IList *other = IList_create();
+    Conn extra[2] = { {.fd = 4}, {.fd = 5} };
+    IList_push(other, &extra[0].link);
+    IList_push(other, &extra[1].link);
+    mu_assert(IList_remove(list, &extra[1].link) == NULL,
+            "Should not remove another list's tail.");
+    mu_assert(IList_count(list) == 2 && IList_count(other) == 2,
+            "Failed remove changed a count.");
+    mu_assert(IList_last(list) == &conns[2].link, "Failed remove moved last.");
+    mu_assert(extra[0].link.next == &extra[1].link, "Other list was unlinked.");
+    IList_destroy(other);
+
+    IList_shift(list);
+    IList_shift(list);
+    mu_assert(IList_remove(list, &conns[0].link) == NULL,
+            "Should not remove from an empty list.");
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_entry);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift_shift);
+    mu_run_test(test_remove);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,137 @@
+#include "minunit.h"
+#include <lcthw/lfqueue.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdint.h>
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define PER_PRODUCER 50000
+
+static LFQueue *queue = NULL;
+static char seen[PRODUCERS][PER_PRODUCER];
+static atomic_int consumed = 0;
+static atomic_int errors = 0;
+
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+
+char *test_create()
+{
+    queue = LFQueue_create();
+    mu_assert(queue != NULL, "Failed to create queue.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    LFQueue_destroy(queue);
+
+    return NULL;
+}
+
+char *test_push_shift()
+{
+    mu_assert(LFQueue_shift(queue) == NULL, "Empty queue should give NULL.");
+
+    mu_assert(LFQueue_push(queue, test1) == 0, "Push failed.");
+    mu_assert(LFQueue_push(queue, test2) == 0, "Push failed.");
+    mu_assert(LFQueue_count(queue) == 2, "Wrong count on push.");
+
+    mu_assert(LFQueue_shift(queue) == test1, "Wrong value on shift.");
+    mu_assert(LFQueue_shift(queue) == test2, "Wrong value on shift.");
+    mu_assert(LFQueue_shift(queue) == NULL, "Drained queue should give NULL.");
+    mu_assert(LFQueue_count(queue) == 0, "Wrong count after shift.");
+
+    return NULL;
+}
+
+// values are (producer, seq) packed in the pointer, offset so never NULL
+static void *producer(void *arg)
+{
+    uintptr_t id = (uintptr_t)arg;
+    uintptr_t seq = 0;
+
+    for (seq = 0; seq < PER_PRODUCER; seq++) {
+        LFQueue_push(queue, (void *)((id << 32 | seq) + 1));
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    long last[PRODUCERS] = { -1, -1, -1, -1 };
+    (void)arg;
+
+    while (atomic_load(&consumed) < PRODUCERS * PER_PRODUCER) {
+        void *value = LFQueue_shift(queue);
+        if (value == NULL) {
+            continue;
+        }
+
+        uintptr_t packed = (uintptr_t)value - 1;
+        int id = packed >> 32;
+        long seq = packed & 0xffffffff;
+
+        // a FIFO can't hand one consumer a producer's values out of order
+        if (seen[id][seq] || seq <= last[id]) {
+            atomic_fetch_add(&errors, 1);
+        }
+
+        seen[id][seq] = 1;
+        last[id] = seq;
+        atomic_fetch_add(&consumed, 1);
+    }
+
+    return NULL;
+}
+
+char *test_mpmc_stress()
+{
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+    uintptr_t i = 0;
+    int j = 0;
+
+    for (i = 0; i < CONSUMERS; i++) {
+        pthread_create(&consumers[i], NULL, consumer, NULL);
+    }
+    for (i = 0; i < PRODUCERS; i++) {
+        pthread_create(&producers[i], NULL, producer, (void *)i);
+    }
+
+    for (i = 0; i < PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (i = 0; i < CONSUMERS; i++) {
+        pthread_join(consumers[i], NULL);
+    }
+
+    mu_assert(atomic_load(&errors) == 0, "Duplicated or reordered values.");
+    mu_assert(LFQueue_count(queue) == 0, "Queue should be drained.");
+    mu_assert(LFQueue_shift(queue) == NULL, "Queue should be empty.");
+
+    for (i = 0; i < PRODUCERS; i++) {
+        for (j = 0; j < PER_PRODUCER; j++) {
+            mu_assert(seen[i][j], "A pushed value was lost.");
+        }
+    }
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_shift);
+    mu_run_test(test_mpmc_stress);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
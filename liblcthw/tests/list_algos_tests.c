@@ -1,5 +1,7 @@
 #include "minunit.h"
 #include <lcthw/list_algos.h>
+#include <lcthw/darray.h>
+#include <lcthw/threadpool.h>
 #include <assert.h>
 #include <string.h>
 
@@ -67,24 +69,633 @@ char *test_merge_sort()
 
     // should work on a list that needs sorting
     List *res = List_merge_sort(words, (List_compare) strcmp);
+    mu_assert(res == words, "Merge sort should sort in place.");
     mu_assert(is_sorted(res), "Words are not sorted after merge sort.");
+    mu_assert(List_count(res) == NUM_VALUES, "Merge sort lost words.");
+    mu_assert(res->first->prev == NULL && res->last->next == NULL,
+            "Merge sort left dangling ends.");
 
     List *res2 = List_merge_sort(res, (List_compare) strcmp);
-    mu_assert(is_sorted(res),
+    mu_assert(is_sorted(res2),
             "Should still be sorted after merge sort.");
-    List_destroy(res2);
-    List_destroy(res);
+
+    // prev links have to agree with next links after relinking
+    LIST_FOREACH(res2, first, next, cur) {
+        if (cur->next) {
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        }
+    }
 
     List_destroy(words);
     return NULL;
 }
 
+int cmp_first_char(const char *a, const char *b)
+{
+    return a[0] - b[0];
+}
+
+char *test_merge_sort_stable()
+{
+    char *stable[] = { "b1", "a1", "b2", "a2", "b3", "a3" };
+    char *expect[] = { "a1", "a2", "a3", "b1", "b2", "b3" };
+    List *words = List_create();
+    int i = 0;
+
+    for (i = 0; i < 6; i++) {
+        List_push(words, stable[i]);
+    }
+
+    List_merge_sort(words, (List_compare) cmp_first_char);
+
+    i = 0;
+    LIST_FOREACH(words, first, next, cur) {
+        mu_assert(cur->value == expect[i], "Merge sort is not stable.");
+        i++;
+    }
+
+    List_destroy(words);
+    return NULL;
+}
+
+typedef struct Keyed {
+    int key;
+    int order;
+} Keyed;
+
+int cmp_keyed(const Keyed * a, const Keyed * b)
+{
+    return a->key - b->key;
+}
+
+char *test_parallel_sort()
+{
+    Keyed items[1000];
+    List *list = List_create();
+    int saved = List_parallel_threshold;
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        items[i].key = (i * 7919) % 37;
+        items[i].order = i;
+        List_push(list, &items[i]);
+    }
+
+    // force the threaded path even on a small list
+    List_parallel_threshold = 0;
+    int rc = List_parallel_sort(list, (List_compare) cmp_keyed, 5);
+    List_parallel_threshold = saved;
+
+    mu_assert(rc == 0, "Parallel sort failed.");
+    mu_assert(List_count(list) == 1000, "Parallel sort lost nodes.");
+    mu_assert(list->first->prev == NULL, "Parallel sort left a first prev.");
+
+    Keyed *last = NULL;
+    LIST_FOREACH(list, first, next, cur) {
+        Keyed *item = cur->value;
+        if (last != NULL) {
+            mu_assert(last->key <= item->key, "Not sorted after parallel sort.");
+            mu_assert(last->key < item->key || last->order < item->order,
+                    "Parallel sort is not stable.");
+            mu_assert(cur->prev->value == last, "Broken prev link.");
+        }
+        last = item;
+    }
+    mu_assert(List_last(list) == last, "Wrong last after parallel sort.");
+
+    rc = List_parallel_sort(list, (List_compare) cmp_keyed, 0);
+    mu_assert(rc == -1, "Parallel sort should reject 0 threads.");
+
+    List_destroy(list);
+    return NULL;
+}
+
+int is_sorted_keyed(List * list)
+{
+    Keyed *last = NULL;
+
+    LIST_FOREACH(list, first, next, cur) {
+        Keyed *item = cur->value;
+        if (last != NULL) {
+            if (last->key > item->key) return 0;
+            // equal keys have to keep their original order
+            if (last->key == item->key && last->order > item->order) return 0;
+            if (cur->prev->value != last) return 0;
+        }
+        last = item;
+    }
+
+    return List_last(list) == last;
+}
+
+char *test_tim_sort()
+{
+    Keyed items[3000];
+    List *list = NULL;
+    int pattern = 0;
+    int i = 0;
+
+    for (pattern = 0; pattern < 5; pattern++) {
+        list = List_create();
+
+        for (i = 0; i < 3000; i++) {
+            switch (pattern) {
+                case 0: items[i].key = i; break;                  // sorted
+                case 1: items[i].key = 3000 - i; break;           // reversed
+                case 2: items[i].key = i + (i % 5 == 0 ? 7 : 0); break;
+                case 3: items[i].key = (i * 7919) % 101; break;   // random-ish
+                default: items[i].key = (i / 100) % 2 ? i : -i;   // mixed runs
+            }
+            items[i].order = i;
+            List_push(list, &items[i]);
+        }
+
+        int rc = List_tim_sort(list, (List_compare) cmp_keyed);
+        mu_assert(rc == 0, "Tim sort failed.");
+        mu_assert(List_count(list) == 3000, "Tim sort lost nodes.");
+        mu_assert(is_sorted_keyed(list), "Tim sort did not sort stably.");
+
+        List_destroy(list);
+    }
+
+    list = create_words();
+    List_tim_sort(list, (List_compare) strcmp);
+    mu_assert(is_sorted(list), "Words are not sorted after tim sort.");
+    List_destroy(list);
+
+    list = List_create();
+    mu_assert(List_tim_sort(list, (List_compare) strcmp) == 0,
+            "Tim sort failed on empty list.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+uint64_t keyed_key(const Keyed * item)
+{
+    // flip the sign bit so negative keys sort first
+    return (uint64_t)(int64_t)item->key ^ (1ULL << 63);
+}
+
+const char *identity_key(const char *value)
+{
+    return value;
+}
+
+char *test_radix_sort()
+{
+    Keyed items[2000];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 2000; i++) {
+        items[i].key = ((i * 7919) % 1009) - 500 + (i % 3) * 100000;
+        items[i].order = i;
+        List_push(list, &items[i]);
+    }
+
+    int rc = List_radix_sort(list, (List_key) keyed_key);
+    mu_assert(rc == 0, "Radix sort failed.");
+    mu_assert(List_count(list) == 2000, "Radix sort lost nodes.");
+    mu_assert(is_sorted_keyed(list), "Radix sort did not sort stably.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *test_radix_sort_str()
+{
+    char words[600][16];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 600; i++) {
+        // lots of shared prefixes, some keys are prefixes of others
+        snprintf(words[i], 16, "k%d", (i * 7919) % 997);
+        if (i % 50 == 0) words[i][0] = '\0';
+        List_push(list, words[i]);
+    }
+
+    int rc = List_radix_sort_str(list, (List_str_key) identity_key);
+    mu_assert(rc == 0, "String radix sort failed.");
+    mu_assert(List_count(list) == 600, "String radix sort lost nodes.");
+    mu_assert(is_sorted(list), "Strings not sorted after radix sort.");
+    LIST_FOREACH(list, first, next, cur) {
+        if (cur->next) {
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        }
+    }
+    mu_assert(list->last->next == NULL, "Last still points somewhere.");
+    List_destroy(list);
+
+    list = create_words();
+    List_radix_sort_str(list, (List_str_key) identity_key);
+    mu_assert(is_sorted(list), "Words not sorted after radix sort.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *test_top_k()
+{
+    Keyed items[2000];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 2000; i++) {
+        items[i].key = (i * 7919) % 2000;
+        items[i].order = i;
+        List_push(list, &items[i]);
+    }
+
+    DArray *top = List_top_k(list, 10, (List_compare) cmp_keyed);
+    mu_assert(top != NULL, "Top k failed.");
+    mu_assert(DArray_count(top) == 10, "Wrong number of top values.");
+    mu_assert(DArray_max(top) == 10, "Top k should only take k slots.");
+    for (i = 0; i < 10; i++) {
+        Keyed *item = DArray_get(top, i);
+        mu_assert(item->key == 1999 - i, "Top k wrong or out of order.");
+    }
+    DArray_destroy(top);
+
+    // asking for more than there is gives all of them
+    top = List_top_k(list, 5000, (List_compare) cmp_keyed);
+    mu_assert(DArray_count(top) == 2000, "Top k should cap at the count.");
+    DArray_destroy(top);
+
+    mu_assert(List_top_k(list, 0, (List_compare) cmp_keyed) == NULL,
+            "Top k should reject k of 0.");
+    mu_assert(List_count(list) == 2000 && is_sorted_keyed(list) == 0,
+            "Top k shouldn't touch the list.");
+
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_nth_element()
+{
+    Keyed items[3000];
+    int ns[] = { 0, 1, 17, 1500, 2998, 2999 };
+    List *list = NULL;
+    int i = 0;
+    int j = 0;
+
+    for (j = 0; j < 6; j++) {
+        list = List_create();
+        for (i = 0; i < 3000; i++) {
+            // lots of equal keys so the equal chain gets exercised
+            items[i].key = (i * 7919) % 300;
+            items[i].order = i;
+            List_push(list, &items[i]);
+        }
+
+        Keyed *nth = List_nth_element(list, ns[j], (List_compare) cmp_keyed);
+        mu_assert(nth != NULL, "nth_element failed.");
+        mu_assert(nth->key == ns[j] / 10, "nth_element got the wrong value.");
+        mu_assert(List_count(list) == 3000, "nth_element lost nodes.");
+
+        i = 0;
+        Keyed *last = NULL;
+        LIST_FOREACH(list, first, next, cur) {
+            Keyed *item = cur->value;
+            if (i < ns[j]) mu_assert(item->key <= nth->key, "Greater before n.");
+            if (i > ns[j]) mu_assert(item->key >= nth->key, "Less after n.");
+            if (last != NULL) mu_assert(cur->prev->value == last, "Broken prev.");
+            last = item;
+            i++;
+        }
+        mu_assert(List_last(list) == last, "Wrong last after nth_element.");
+
+        List_destroy(list);
+    }
+
+    list = List_create();
+    mu_assert(List_nth_element(list, 0, (List_compare) cmp_keyed) == NULL,
+            "nth_element of an empty list should fail.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *test_merge_many()
+{
+    Keyed items[7][100];
+    List *lists[7];
+    int i = 0;
+    int j = 0;
+
+    for (i = 0; i < 7; i++) {
+        lists[i] = List_create();
+        // list 3 stays empty, the rest overlap with lots of equal keys
+        for (j = 0; i != 3 && j < 100; j++) {
+            items[i][j].key = j * (i + 1) / 3;
+            items[i][j].order = i * 1000 + j;
+            List_push(lists[i], &items[i][j]);
+        }
+    }
+
+    // the lazy form only reads the lists
+    ListMerge *merge = ListMerge_create(lists, 7, (List_compare) cmp_keyed);
+    ListNode *node = NULL;
+    Keyed *last = NULL;
+    int seen = 0;
+    mu_assert(merge != NULL, "Failed to create merge.");
+
+    while ((node = ListMerge_next(merge)) != NULL) {
+        Keyed *item = node->value;
+        if (last != NULL) {
+            mu_assert(last->key < item->key ||
+                    (last->key == item->key && last->order < item->order),
+                    "Merge iterator out of order or not stable.");
+        }
+        last = item;
+        seen++;
+    }
+    mu_assert(seen == 600, "Merge iterator missed nodes.");
+    mu_assert(List_count(lists[0]) == 100, "Merge iterator changed a list.");
+    ListMerge_destroy(merge);
+
+    List *merged = List_merge_many(lists, 7, (List_compare) cmp_keyed);
+    mu_assert(merged != NULL, "Merge many failed.");
+    mu_assert(List_count(merged) == 600, "Merge many lost nodes.");
+    mu_assert(is_sorted_keyed(merged), "Merge many not sorted or not stable.");
+
+    for (i = 0; i < 7; i++) {
+        mu_assert(List_count(lists[i]) == 0 && lists[i]->first == NULL,
+                "Merge many should empty its inputs.");
+        List_destroy(lists[i]);
+    }
+    List_destroy(merged);
+
+    // a single list comes through as it was
+    lists[0] = create_words();
+    List_merge_sort(lists[0], (List_compare) strcmp);
+    merged = List_merge_many(lists, 1, (List_compare) strcmp);
+    mu_assert(List_count(merged) == NUM_VALUES && is_sorted(merged),
+            "Merge of one list broke it.");
+    List_destroy(merged);
+    List_destroy(lists[0]);
+
+    // pooled lists merge if they share the pool, and not with anything else
+    lists[0] = List_create_pooled(8);
+    lists[1] = List_create();
+    List_push(lists[0], "b");
+    List_push(lists[1], "a");
+    mu_assert(List_merge_many(lists, 2, (List_compare) strcmp) == NULL,
+            "Merge many should refuse lists that don't share nodes.");
+    List_destroy(lists[1]);
+
+    lists[1] = List_create_sharing(lists[0]);
+    List_push(lists[1], "a");
+    merged = List_merge_many(lists, 2, (List_compare) strcmp);
+    mu_assert(merged != NULL && List_count(merged) == 2 &&
+            strcmp(merged->first->value, "a") == 0,
+            "Merge of lists sharing a pool failed.");
+    List_destroy(lists[0]);
+    List_destroy(lists[1]);
+    List_destroy(merged);
+
+    return NULL;
+}
+
+uint64_t coarse_key(const Keyed * item)
+{
+    // keeps the order but lumps keys together, so cmp has ties to break
+    return keyed_key(item) >> 4;
+}
+
+char *test_cached_sort()
+{
+    Keyed items[2000];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 2000; i++) {
+        items[i].key = ((i * 7919) % 1009) - 500;
+        items[i].order = i;
+        List_push(list, &items[i]);
+    }
+
+    int rc = List_cached_sort(list, (List_key) coarse_key,
+            (List_compare) cmp_keyed);
+    mu_assert(rc == 0, "Cached sort failed.");
+    mu_assert(List_count(list) == 2000, "Cached sort lost nodes.");
+    mu_assert(is_sorted_keyed(list), "Cached sort did not sort stably.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *test_cached_sort_str()
+{
+    char words[800][48];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 800; i++) {
+        // long shared prefixes, and some keys are prefixes of others
+        snprintf(words[i], 48, "/var/log/app/%d/worker-%d.log",
+                (i * 7919) % 7, (i * 31) % 97);
+        if (i % 40 == 0) words[i][13] = '\0';
+        if (i % 100 == 0) words[i][0] = '\0';
+        List_push(list, words[i]);
+    }
+
+    int rc = List_cached_sort_str(list, (List_str_key) identity_key);
+    mu_assert(rc == 0, "Cached string sort failed.");
+    mu_assert(List_count(list) == 800, "Cached string sort lost nodes.");
+    mu_assert(is_sorted(list), "Strings not sorted after cached sort.");
+
+    char *last = NULL;
+    LIST_FOREACH(list, first, next, cur) {
+        // equal strings keep their order, they're separate buffers here
+        if (last != NULL && strcmp(last, cur->value) == 0) {
+            mu_assert(last < (char *)cur->value, "Cached string sort not stable.");
+        }
+        if (cur->next) mu_assert(cur->next->prev == cur, "Broken prev link.");
+        last = cur->value;
+    }
+    mu_assert(List_last(list) == last, "Wrong last after cached sort.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+// records the order values come in, as ints counting up from 0
+static void expect_next(void *value, void *ctx)
+{
+    intptr_t *next = ctx;
+    if ((intptr_t)value == *next) {
+        (*next)++;
+    } else {
+        *next = -1000000;
+    }
+}
+
+static void *double_it(void *value, void *ctx)
+{
+    (void)ctx;
+    return (void *)((intptr_t)value * 2);
+}
+
+static void expect_chunk(ListNode ** nodes, int n, void *ctx)
+{
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        expect_next(nodes[i]->value, ctx);
+    }
+
+    // no chunk should be empty or over size
+    if (n < 1 || n > LIST_PREFETCH_CHUNK) {
+        *(intptr_t *)ctx = -1000000;
+    }
+}
+
+char *test_prefetch_walks()
+{
+    List *list = List_create();
+    intptr_t n = 0;
+    intptr_t i = 0;
+
+    // every length around the walk's lead and the chunk size
+    for (n = 0; n <= LIST_PREFETCH_CHUNK * 2 + 1; n++) {
+        intptr_t next = 0;
+        List_foreach_batch(list, expect_next, &next);
+        mu_assert(next == n, "foreach_batch skipped or reordered values.");
+
+        next = 0;
+        List_foreach_chunked(list, expect_chunk, &next);
+        mu_assert(next == n, "foreach_chunked skipped or reordered values.");
+
+        List_map(list, double_it, NULL);
+        i = 0;
+        LIST_FOREACH(list, first, next, cur) {
+            mu_assert(cur->value == (void *)(i * 2), "List_map missed a value.");
+            cur->value = (void *)i;
+            i++;
+        }
+
+        List_push(list, (void *)n);
+    }
+
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_split()
+{
+    List *list = List_create();
+    ListNode *starts[7];
+    int counts[7];
+    int i = 0;
+    int n = 0;
+
+    for (n = 0; n <= 23; n++) {
+        int k = List_split(list, 7, starts, counts);
+        int expect = n < 7 ? n : 7;
+        mu_assert(k == expect, "Wrong number of runs.");
+
+        // every run starts right after the one before ends
+        ListNode *node = list->first;
+        for (i = 0; i < k; i++) {
+            mu_assert(starts[i] == node, "Run starts in the wrong place.");
+            mu_assert(counts[i] == n / k || counts[i] == n / k + 1,
+                    "Runs aren't balanced.");
+            int j = 0;
+            for (j = 0; j < counts[i]; j++) {
+                node = node->next;
+            }
+        }
+        mu_assert(node == NULL, "Runs don't cover the list.");
+
+        List_push(list, (void *)(intptr_t)n);
+    }
+
+    mu_assert(List_split(list, 0, starts, counts) == -1,
+            "Should reject 0 runs.");
+
+    List_destroy(list);
+    return NULL;
+}
+
+static void *square(void *value, void *ctx)
+{
+    intptr_t x = (intptr_t)value;
+    (void)ctx;
+    return (void *)(x * x);
+}
+
+static void *add(void *acc, void *value, void *ctx)
+{
+    (void)ctx;
+    return (void *)((intptr_t)acc + (intptr_t)value);
+}
+
+// not commutative, so runs combined out of order would show
+static void *keep_first(void *acc, void *value, void *ctx)
+{
+    (void)ctx;
+    return acc != NULL ? acc : value;
+}
+
+char *test_parallel_map_reduce()
+{
+    ThreadPool *pool = ThreadPool_create(3);
+    List *list = List_create();
+    intptr_t expect = 0;
+    intptr_t i = 0;
+
+    mu_assert(List_parallel_reduce(pool, list, (void *)7, add, add, NULL) ==
+            (void *)7, "Empty reduce should give init.");
+    mu_assert(List_parallel_map(pool, list, square, NULL) == 0,
+            "Empty map failed.");
+
+    for (i = 0; i < 1000; i++) {
+        List_push(list, (void *)i);
+        expect += i * i;
+    }
+
+    mu_assert(List_parallel_map(pool, list, square, NULL) == 0, "Map failed.");
+
+    i = 0;
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert(cur->value == (void *)(i * i), "Map missed a value.");
+        i++;
+    }
+
+    void *sum = List_parallel_reduce(pool, list, NULL, add, add, NULL);
+    mu_assert(sum == (void *)expect, "Wrong parallel sum.");
+
+    List_shift(list);
+    void *first = List_parallel_reduce(pool, list, NULL, keep_first,
+            keep_first, NULL);
+    mu_assert(first == (void *)1, "Runs combined out of order.");
+
+    List_destroy(list);
+    ThreadPool_destroy(pool);
+    return NULL;
+}
+
 char *all_tests()
 {
     mu_suite_start();
 
     mu_run_test(test_bubble_sort);
     mu_run_test(test_merge_sort);
+    mu_run_test(test_merge_sort_stable);
+    mu_run_test(test_parallel_sort);
+    mu_run_test(test_tim_sort);
+    mu_run_test(test_radix_sort);
+    mu_run_test(test_radix_sort_str);
+    mu_run_test(test_top_k);
+    mu_run_test(test_nth_element);
+    mu_run_test(test_merge_many);
+    mu_run_test(test_cached_sort);
+    mu_run_test(test_cached_sort_str);
+    mu_run_test(test_prefetch_walks);
+    mu_run_test(test_split);
+    mu_run_test(test_parallel_map_reduce);
 
     return NULL;
 }
@@ -0,0 +1,160 @@
+#include "minunit.h"
+#include <lcthw/list_external.h>
+
+typedef struct Record {
+    int key;
+    int order;
+} Record;
+
+static int cmp_record(const Record * a, const Record * b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+static int write_record(const Record * rec, FILE * out)
+{
+    return fwrite(rec, sizeof(Record), 1, out) == 1 ? 0 : -1;
+}
+
+static void *read_record(FILE * in)
+{
+    Record *rec = malloc(sizeof(Record));
+
+    if (rec != NULL && fread(rec, sizeof(Record), 1, in) != 1) {
+        free(rec);
+        return NULL;
+    }
+
+    return rec;
+}
+
+static size_t size_record(const void *value)
+{
+    (void)value;
+    return sizeof(Record);
+}
+
+static List *make_records(int n)
+{
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        Record *rec = malloc(sizeof(Record));
+        rec->key = (i * 7919) % 503;
+        rec->order = i;
+        List_push(list, rec);
+    }
+
+    return list;
+}
+
+static char *check_sorted(List * list, int n)
+{
+    Record *last = NULL;
+
+    mu_assert(List_count(list) == n, "External sort lost values.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        Record *rec = cur->value;
+        if (last != NULL) {
+            mu_assert(last->key <= rec->key, "External sort didn't sort.");
+            mu_assert(last->key < rec->key || last->order < rec->order,
+                    "External sort isn't stable.");
+        }
+        last = rec;
+    }
+
+    return NULL;
+}
+
+char *test_spills()
+{
+    ListExternal ext = {.cmp = (List_compare) cmp_record,
+        .write = (List_serialize) write_record,.read = read_record,
+        .size = size_record,.free_value = free,
+        // a few hundred records a run, and 3 runs per merge for more passes
+        .mem_cap = 200 * (sizeof(ListNode) + sizeof(Record)),.fan_in = 3
+    };
+    List *in = make_records(5000);
+    List *out = List_create();
+
+    int rc = List_external_sort(&ext, List_external_shift, in,
+            List_external_push, out);
+    mu_assert(rc == 0, "External sort failed.");
+    mu_assert(List_count(in) == 0, "Source wasn't drained.");
+
+    char *msg = check_sorted(out, 5000);
+    if (msg) return msg;
+
+    mu_assert(ext.stats.runs == 25, "Wrong number of runs.");
+    mu_assert(ext.stats.passes == 3, "25 runs 3 at a time is 3 passes.");
+    mu_assert(ext.stats.bytes_spilled == 3 * 5000 * (long)sizeof(Record),
+            "Every pass should spill every record once.");
+
+    List_clear_destroy(out);
+    List_destroy(in);
+    return NULL;
+}
+
+char *test_in_memory()
+{
+    ListExternal ext = {.cmp = (List_compare) cmp_record,
+        .write = (List_serialize) write_record,.read = read_record,
+        .size = size_record,.free_value = free,.mem_cap = 1 << 20
+    };
+    List *in = make_records(1000);
+    List *out = List_create();
+
+    int rc = List_external_sort(&ext, List_external_shift, in,
+            List_external_push, out);
+    mu_assert(rc == 0, "External sort failed.");
+
+    char *msg = check_sorted(out, 1000);
+    if (msg) return msg;
+
+    mu_assert(ext.stats.runs == 0 && ext.stats.bytes_spilled == 0,
+            "A list under the cap shouldn't touch the disk.");
+
+    List_clear_destroy(out);
+    List_destroy(in);
+    return NULL;
+}
+
+static int refuse_after(void *value, void *ctx)
+{
+    int *left = ctx;
+    free(value);
+    return (*left)-- > 0 ? 0 : -1;
+}
+
+char *test_sink_error()
+{
+    ListExternal ext = {.cmp = (List_compare) cmp_record,
+        .write = (List_serialize) write_record,.read = read_record,
+        .size = size_record,.free_value = free,
+        .mem_cap = 100 * (sizeof(ListNode) + sizeof(Record))
+    };
+    List *in = make_records(1000);
+    int left = 10;
+
+    int rc = List_external_sort(&ext, List_external_shift, in,
+            refuse_after, &left);
+    mu_assert(rc == -1, "A sink error should fail the sort.");
+
+    List_destroy(in);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_spills);
+    mu_run_test(test_in_memory);
+    mu_run_test(test_sink_error);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,211 @@
+#include "minunit.h"
+#include <lcthw/list_snapshot.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NUM_WORDS 1000
+
+typedef struct Point {
+    double x;
+    int id;
+} Point;
+
+static char path[64];
+static char words[NUM_WORDS][16];
+
+static const void *str_bytes(const void *value, size_t *size)
+{
+    *size = strlen(value) + 1;
+    return value;
+}
+
+static const void *point_bytes(const void *value, size_t *size)
+{
+    *size = sizeof(Point);
+    return value;
+}
+
+static List *create_words()
+{
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < NUM_WORDS; i++) {
+        // lengths from 1 to 10 so the padding changes record to record
+        snprintf(words[i], sizeof(words[i]), "%.*s%d", i % 7, "abcdefg", i);
+        List_push(list, words[i]);
+    }
+
+    return list;
+}
+
+// overwrites len bytes at offset in the saved file
+static void corrupt(long offset, const void *bytes, size_t len)
+{
+    FILE *file = fopen(path, "r+b");
+    assert(file != NULL);
+    fseek(file, offset, SEEK_SET);
+    fwrite(bytes, 1, len, file);
+    fclose(file);
+}
+
+char *test_save_load()
+{
+    List *list = create_words();
+    int i = 0;
+
+    snprintf(path, sizeof(path), "/tmp/lcthw_snapshot_%d", (int)getpid());
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    mu_assert(access(path, F_OK) == 0, "Snapshot wasn't written.");
+
+    ListSnapshot *snap = List_load_mmap(path);
+    mu_assert(snap != NULL, "Load failed.");
+    mu_assert(ListSnapshot_count(snap) == NUM_WORDS, "Wrong count.");
+    mu_assert(ListSnapshot_verify(snap) == 0, "Verify failed on a good file.");
+
+    LIST_SNAPSHOT_FOREACH(snap, rec) {
+        mu_assert(strcmp((const char *)rec->data, words[i]) == 0,
+                "Wrong record.");
+        mu_assert(rec->size == strlen(words[i]) + 1, "Wrong record size.");
+        mu_assert(((uintptr_t)rec & 7) == 0, "Record isn't aligned.");
+        i++;
+    }
+    mu_assert(i == NUM_WORDS, "Walk missed records.");
+
+    List *loaded = ListSnapshot_to_list(snap);
+    mu_assert(loaded != NULL && List_count(loaded) == NUM_WORDS,
+            "to_list failed.");
+
+    ListNode *orig = list->first;
+    LIST_FOREACH(loaded, first, next, cur) {
+        mu_assert(strcmp(cur->value, orig->value) == 0, "Wrong loaded value.");
+        orig = orig->next;
+    }
+
+    List_destroy(loaded);
+    ListSnapshot_close(snap);
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_structs()
+{
+    Point points[3] = { {1.5, 1}, {-2.25, 2}, {1e100, 3} };
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 3; i++) {
+        List_push(list, &points[i]);
+    }
+
+    mu_assert(List_save(list, path, point_bytes) == 0, "Save failed.");
+
+    // the struct is read straight out of the map
+    ListSnapshot *snap = List_load_mmap(path);
+    List *loaded = ListSnapshot_to_list(snap);
+    i = 0;
+    LIST_FOREACH(loaded, first, next, cur) {
+        const Point *p = cur->value;
+        mu_assert(p->x == points[i].x && p->id == points[i].id,
+                "Struct came back wrong.");
+        i++;
+    }
+
+    List_destroy(loaded);
+    ListSnapshot_close(snap);
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_empty()
+{
+    List *list = List_create();
+
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save of empty failed.");
+
+    ListSnapshot *snap = List_load_mmap(path);
+    mu_assert(snap != NULL && ListSnapshot_count(snap) == 0,
+            "Load of empty failed.");
+    mu_assert(ListSnapshot_first(snap) == NULL, "Empty has a record.");
+    mu_assert(ListSnapshot_verify(snap) == 0, "Empty doesn't verify.");
+
+    List *loaded = ListSnapshot_to_list(snap);
+    mu_assert(loaded != NULL && List_count(loaded) == 0, "Empty to_list.");
+
+    List_destroy(loaded);
+    ListSnapshot_close(snap);
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_corrupt()
+{
+    List *list = create_words();
+    ListSnapshotHeader header;
+    uint64_t huge = UINT64_MAX;
+    long first_record = sizeof(ListSnapshotHeader);
+
+    mu_assert(List_load_mmap("/tmp/lcthw_snapshot_missing") == NULL,
+            "Loaded a file that isn't there.");
+
+    // a flipped byte in a value only shows up in verify
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    corrupt(first_record + 8, "Z", 1);
+    ListSnapshot *snap = List_load_mmap(path);
+    mu_assert(snap != NULL, "Load shouldn't read past the header.");
+    mu_assert(ListSnapshot_verify(snap) == -1, "Verify missed a bad byte.");
+    ListSnapshot_close(snap);
+
+    // a length running off the end stops the walk instead of overrunning
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    corrupt(first_record, &huge, sizeof(huge));
+    snap = List_load_mmap(path);
+    mu_assert(ListSnapshot_first(snap) == NULL, "Walked a bad length.");
+    mu_assert(ListSnapshot_to_list(snap) == NULL, "to_list took a bad file.");
+    mu_assert(ListSnapshot_verify(snap) == -1, "Verify missed a bad length.");
+    ListSnapshot_close(snap);
+
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    corrupt(0, "NOTASNAP", 8);
+    mu_assert(List_load_mmap(path) == NULL, "Loaded a bad magic.");
+
+    // cut short, the header's byte count doesn't match anymore
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    mu_assert(truncate(path, first_record + 100) == 0, "Failed to truncate.");
+    mu_assert(List_load_mmap(path) == NULL, "Loaded a truncated file.");
+
+    mu_assert(truncate(path, 10) == 0, "Failed to truncate.");
+    mu_assert(List_load_mmap(path) == NULL, "Loaded a file with no header.");
+
+    mu_assert(List_save(list, path, str_bytes) == 0, "Save failed.");
+    FILE *file = fopen(path, "rb");
+    mu_assert(fread(&header, sizeof(header), 1, file) == 1, "Read failed.");
+    fclose(file);
+    header.count = header.bytes;
+    corrupt(0, &header, sizeof(header));
+    mu_assert(List_load_mmap(path) == NULL, "Loaded an impossible count.");
+
+    // a save that can't be written leaves nothing behind
+    mu_assert(List_save(list, "/nonexistent/dir/snap", str_bytes) == -1,
+            "Save to a bad path should fail.");
+
+    remove(path);
+    List_destroy(list);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_save_load);
+    mu_run_test(test_structs);
+    mu_run_test(test_empty);
+    mu_run_test(test_corrupt);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
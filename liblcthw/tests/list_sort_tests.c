@@ -0,0 +1,113 @@
+#include "minunit.h"
+#include <lcthw/list_sort.h>
+#include <assert.h>
+
+typedef struct Keyed {
+    int key;
+    int order;
+} Keyed;
+
+#define CMP_KEYED(A, B) ((A)->key - (B)->key)
+
+LIST_DEFINE_SORT(List_sort_int, int *, LIST_CMP_INT)
+LIST_DEFINE_SORT(List_sort_str, char *, LIST_CMP_STR)
+LIST_DEFINE_SORT(List_sort_keyed, Keyed *, CMP_KEYED)
+
+char *test_sort_int()
+{
+    int values[] = { 5, -3, 9, 0, 9, -3, 2147483647, -2147483647 - 1 };
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 8; i++) {
+        List_push(list, &values[i]);
+    }
+
+    mu_assert(List_sort_int(list) == list, "Should sort in place.");
+    mu_assert(List_count(list) == 8, "Sort lost nodes.");
+
+    LIST_FOREACH(list, first, next, cur) {
+        if (cur->next) {
+            mu_assert(*(int *)cur->value <= *(int *)cur->next->value,
+                    "Ints are not sorted.");
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        }
+    }
+    mu_assert(*(int *)List_first(list) == -2147483647 - 1,
+            "Overflowed on INT_MIN.");
+
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_sort_str()
+{
+    char *words[] = { "XXXX", "1234", "abcd", "abc", "xjvef", "NDSS", "" };
+    char *expect[] = { "", "1234", "NDSS", "XXXX", "abc", "abcd", "xjvef" };
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 7; i++) {
+        List_push(list, words[i]);
+    }
+
+    List_sort_str(list);
+
+    i = 0;
+    LIST_FOREACH(list, first, next, cur) {
+        mu_assert(strcmp(cur->value, expect[i]) == 0, "Strings not sorted.");
+        i++;
+    }
+    mu_assert(List_last(list) == words[4], "Wrong last after sort.");
+
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_sort_stable()
+{
+    Keyed items[500];
+    List *list = List_create();
+    int i = 0;
+
+    for (i = 0; i < 500; i++) {
+        items[i].key = (i * 31) % 7;
+        items[i].order = i;
+        List_push(list, &items[i]);
+    }
+
+    List_sort_keyed(list);
+
+    Keyed *last = NULL;
+    LIST_FOREACH(list, first, next, cur) {
+        Keyed *item = cur->value;
+        if (last != NULL) {
+            mu_assert(last->key < item->key ||
+                    (last->key == item->key && last->order < item->order),
+                    "Specialized sort is not stable.");
+        }
+        last = item;
+    }
+
+    List_destroy(list);
+
+    list = List_create();
+    List_sort_keyed(list);
+    mu_assert(List_count(list) == 0, "Sorting empty list failed.");
+    List_destroy(list);
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_sort_int);
+    mu_run_test(test_sort_str);
+    mu_run_test(test_sort_stable);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -1,6 +1,7 @@
 #include "minunit.h"
 #include <lcthw/list.h>
 #include <assert.h>
+#include <string.h>
 
 static List *list = NULL;
 char *test1 = "test1 data";
@@ -91,6 +92,181 @@ char *test_shift()
     return NULL;
 }
 
+char *test_pooled()
+{
+    int i = 0;
+    List *pooled = List_create_pooled(2);
+    mu_assert(pooled != NULL, "Failed to create pooled list.");
+    mu_assert(List_create_pooled(0) == NULL,
+            "Should not create a pool with no nodes per block.");
+
+    List_push(pooled, test1);
+    List_push(pooled, test2);
+    List_unshift(pooled, test3);
+    mu_assert(List_count(pooled) == 3, "Wrong count on pooled push.");
+    mu_assert(List_first(pooled) == test3, "Wrong first on pooled list.");
+    mu_assert(List_last(pooled) == test2, "Wrong last on pooled list.");
+
+    ListNode *recycled = pooled->first->next;
+    mu_assert(List_remove(pooled, recycled) == test1,
+            "Wrong value removed from pooled list.");
+
+    // the freed node should be handed out again, cleanly
+    List_push(pooled, test1);
+    mu_assert(pooled->last == recycled, "Pooled node was not recycled.");
+    mu_assert(recycled->next == NULL, "Recycled node has a stale next.");
+    mu_assert(recycled->prev != NULL, "Recycled node was not linked.");
+
+    for (i = 0; i < 100; i++) {
+        List_push(pooled, test1);
+        mu_assert(List_shift(pooled) != NULL, "Shift from pool failed.");
+    }
+    mu_assert(List_count(pooled) == 3, "Wrong count after pool churn.");
+
+    List_destroy(pooled);
+
+    return NULL;
+}
+
+char *test_push_many()
+{
+    char *values[] = { test1, test2, test3, test1, test2 };
+    List *lists[2] = { List_create(), List_create_pooled(4) };
+    int i = 0;
+
+    for (i = 0; i < 2; i++) {
+        List *list = lists[i];
+
+        List_push(list, test3);
+        mu_assert(List_push_many(list, (void **)values, 5) == 0,
+                "push_many failed.");
+        mu_assert(List_push_many(list, (void **)values, 0) == 0,
+                "Empty push_many failed.");
+        mu_assert(List_count(list) == 6, "Wrong count after push_many.");
+        mu_assert(List_first(list) == test3, "push_many moved first.");
+        mu_assert(List_last(list) == test2, "Wrong last after push_many.");
+        mu_assert(list->first->next->prev == list->first,
+                "push_many didn't link onto the old last.");
+
+        int j = 0;
+        LIST_FOREACH(list, first, next, cur) {
+            if (j > 0) {
+                mu_assert(cur->value == values[j - 1], "Wrong value order.");
+                mu_assert(cur->prev->next == cur, "Broken prev link.");
+            }
+            j++;
+        }
+
+        // batch nodes are freed one at a time like any other
+        mu_assert(List_pop(list) == test2, "Pop after push_many failed.");
+        List_push(list, test3);
+        mu_assert(List_last(list) == test3, "Push after push_many failed.");
+
+        List_destroy(list);
+    }
+
+    return NULL;
+}
+
+static int check_links(List * list)
+{
+    ListNode *prev = NULL;
+    int count = 0;
+
+    LIST_FOREACH(list, first, next, cur) {
+        if (cur->prev != prev) return 0;
+        prev = cur;
+        count++;
+    }
+
+    return prev == list->last && count == List_count(list);
+}
+
+char *test_splice()
+{
+    char *values[] = { "0", "1", "2", "3", "4", "5" };
+    int pooled = 0;
+
+    for (pooled = 0; pooled < 2; pooled++) {
+        List *a = pooled ? List_create_pooled(4) : List_create();
+        List *b = List_create_sharing(a);
+
+        List_push_many(a, (void **)values, 6);
+        List_push(b, "x");
+        List_push(b, "y");
+
+        // 1..3 in between x and y
+        ListNode *first = a->first->next;
+        ListNode *last = first->next->next;
+        mu_assert(List_splice(b, b->last, a, first, last, 3) == 0,
+                "Splice failed.");
+        mu_assert(List_count(a) == 3 && List_count(b) == 5,
+                "Wrong counts after splice.");
+        mu_assert(check_links(a) && check_links(b), "Splice broke links.");
+        mu_assert(strcmp(b->first->next->value, "1") == 0 &&
+                strcmp(b->last->prev->value, "3") == 0,
+                "Range landed in the wrong place.");
+        mu_assert(b->first->next == first, "Shared nodes should move.");
+
+        // the rest of a on the front of b, counting it
+        mu_assert(List_splice(b, b->first, a, a->first, a->last, -1) == 0,
+                "Splice with counting failed.");
+        mu_assert(List_count(a) == 0 && a->first == NULL && a->last == NULL,
+                "Splice should empty a.");
+        mu_assert(List_count(b) == 8 && check_links(b),
+                "Wrong list after front splice.");
+        mu_assert(strcmp(b->first->value, "0") == 0, "Wrong first after splice.");
+
+        List *rest = List_split_at(b, b->first->next->next->next, -1);
+        mu_assert(rest != NULL, "Split failed.");
+        mu_assert(List_count(b) == 3 && List_count(rest) == 5,
+                "Wrong counts after split.");
+        mu_assert(check_links(b) && check_links(rest), "Split broke links.");
+        mu_assert(strcmp(b->last->value, "5") == 0 &&
+                strcmp(rest->first->value, "x") == 0, "Split in wrong place.");
+
+        mu_assert(List_join(a, rest) == 0 && List_join(a, b) == 0,
+                "Join failed.");
+        mu_assert(List_join(a, a) == -1, "Join to itself should fail.");
+        mu_assert(List_count(a) == 8 && List_count(b) == 0 &&
+                List_count(rest) == 0 && check_links(a),
+                "Wrong lists after join.");
+        mu_assert(strcmp(a->first->value, "x") == 0 &&
+                strcmp(a->last->value, "5") == 0, "Wrong order after join.");
+
+        // destroying one of the sharing lists leaves the rest usable
+        List_destroy(rest);
+        List_destroy(b);
+        List_push(a, "z");
+        mu_assert(List_count(a) == 9 && check_links(a), "Pool went away early.");
+        List_destroy(a);
+    }
+
+    return NULL;
+}
+
+char *test_splice_copies()
+{
+    List *a = List_create_pooled(4);
+    List *b = List_create();
+
+    List_push(a, test1);
+    List_push(a, test2);
+    List_push(b, test3);
+
+    // different pools, so the values move and the nodes don't
+    ListNode *node = a->first;
+    mu_assert(List_join(b, a) == 0, "Join across pools failed.");
+    mu_assert(List_count(a) == 0 && List_count(b) == 3 && check_links(b),
+            "Wrong lists after join across pools.");
+    mu_assert(b->first->next != node && List_last(b) == test2,
+            "Values should move to new nodes.");
+
+    List_destroy(a);
+    List_destroy(b);
+    return NULL;
+}
+
 char *all_tests()
 {
     mu_suite_start();
@@ -101,6 +277,10 @@ char *all_tests()
     mu_run_test(test_remove);
     mu_run_test(test_shift);
     mu_run_test(test_destroy);
+    mu_run_test(test_pooled);
+    mu_run_test(test_push_many);
+    mu_run_test(test_splice);
+    mu_run_test(test_splice_copies);
 
     return NULL;
 }
@@ -0,0 +1,217 @@
+#include "minunit.h"
+#include <lcthw/plist.h>
+#include <lcthw/darray.h>
+#include <stdint.h>
+
+#define READERS 3
+#define WINDOW 100
+#define WRITES 200000
+
+static PList *list = NULL;
+static atomic_int done = 0;
+static atomic_int errors = 0;
+static atomic_int snapshots = 0;
+
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_create()
+{
+    list = PList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+    mu_assert(PList_count(list) == 0, "New list isn't empty.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    PList_destroy(list);
+
+    return NULL;
+}
+
+char *test_push_shift()
+{
+    mu_assert(PList_shift(list) == NULL, "Empty list should give NULL.");
+
+    mu_assert(PList_push(list, test1) == 0, "Push failed.");
+    mu_assert(PList_push(list, test2) == 0, "Push failed.");
+    mu_assert(PList_count(list) == 2, "Wrong count on push.");
+
+    mu_assert(PList_shift(list) == test1, "Wrong value on shift.");
+    mu_assert(PList_shift(list) == test2, "Wrong value on shift.");
+    mu_assert(PList_count(list) == 0, "Wrong count on shift.");
+
+    // pushing onto a list that was emptied starts a fresh chain
+    mu_assert(PList_push(list, test3) == 0, "Push failed.");
+    mu_assert(PList_shift(list) == test3, "Wrong value after emptying.");
+
+    return NULL;
+}
+
+char *test_snapshot()
+{
+    PList_push(list, test1);
+    PList_push(list, test2);
+
+    PListSnapshot snap = PList_snapshot(list);
+    mu_assert(snap.count == 2, "Wrong snapshot count.");
+
+    // the snapshot keeps seeing what was there when it was taken
+    PList_push(list, test3);
+    mu_assert(PList_shift(list) == test1, "Wrong value on shift.");
+
+    PListSnapshot later = PList_snapshot(list);
+    mu_assert(later.count == 2, "Nested snapshot has the wrong count.");
+
+    char *expect[] = { test1, test2 };
+    int i = 0;
+    PLIST_FOREACH(snap, cur) {
+        mu_assert(i < 2 && cur->value == expect[i], "Snapshot changed.");
+        i++;
+    }
+    mu_assert(i == 2, "Snapshot walked past its last node.");
+
+    PList_release(&later);
+    PList_release(&snap);
+    mu_assert(snap.first == NULL && snap.count == 0,
+            "Release should empty the handle.");
+
+    // a second release is a no-op, it mustn't unbalance the next snapshot
+    PList_release(&snap);
+
+    PList_shift(list);
+    PList_shift(list);
+    mu_assert(PList_count(list) == 0, "List should be empty.");
+
+    return NULL;
+}
+
+char *test_reclaim()
+{
+    PList *local = PList_create();
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        PList_push(local, test1);
+        PList_shift(local);
+    }
+
+    // with nobody reading, a couple of passes free the lot
+    PList_reclaim(local);
+    PList_reclaim(local);
+    PList_reclaim(local);
+    mu_assert(DArray_count(local->limbo) == 0, "Retired nodes weren't freed.");
+
+    // a held snapshot holds back everything retired since it was taken
+    PListSnapshot snap = PList_snapshot(local);
+    for (i = 0; i < 1000; i++) {
+        PList_push(local, test1);
+        PList_shift(local);
+    }
+    PList_reclaim(local);
+    PList_reclaim(local);
+    mu_assert(DArray_count(local->limbo) >= 3000 - 64 * 2,
+            "Freed what a reader could still see.");
+
+    PList_release(&snap);
+    PList_reclaim(local);
+    PList_reclaim(local);
+    PList_reclaim(local);
+    mu_assert(DArray_count(local->limbo) == 0, "Release didn't let them go.");
+
+    PList_destroy(local);
+    return NULL;
+}
+
+/*
+ * The writer keeps a sliding window of consecutive numbers, so every
+ * snapshot has to be a run of consecutive numbers of its own count.
+ */
+static void *writer(void *arg)
+{
+    PList *plist = arg;
+    intptr_t i = 0;
+
+    for (i = 1; i <= WRITES; i++) {
+        PList_push(plist, (void *)i);
+        if (i > WINDOW) {
+            PList_shift(plist);
+        }
+    }
+
+    atomic_store(&done, 1);
+    return NULL;
+}
+
+static void *reader(void *arg)
+{
+    PList *plist = arg;
+
+    while (!atomic_load(&done)) {
+        PListSnapshot snap = PList_snapshot(plist);
+        intptr_t last = 0;
+        int count = 0;
+
+        PLIST_FOREACH(snap, cur) {
+            intptr_t value = (intptr_t)cur->value;
+            if (last != 0 && value != last + 1) {
+                atomic_fetch_add(&errors, 1);
+            }
+            last = value;
+            count++;
+        }
+
+        if (count != snap.count) {
+            atomic_fetch_add(&errors, 1);
+        }
+
+        PList_release(&snap);
+        atomic_fetch_add(&snapshots, 1);
+    }
+
+    return NULL;
+}
+
+char *test_readers_writer()
+{
+    PList *shared = PList_create();
+    pthread_t readers[READERS];
+    pthread_t write_thread;
+    int i = 0;
+
+    for (i = 0; i < READERS; i++) {
+        pthread_create(&readers[i], NULL, reader, shared);
+    }
+    pthread_create(&write_thread, NULL, writer, shared);
+
+    pthread_join(write_thread, NULL);
+    for (i = 0; i < READERS; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    mu_assert(atomic_load(&errors) == 0, "A reader saw a torn version.");
+    mu_assert(PList_count(shared) == WINDOW, "Wrong count after the run.");
+    mu_assert(atomic_load(&snapshots) > 0, "Readers never got a look in.");
+
+    PList_destroy(shared);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_shift);
+    mu_run_test(test_snapshot);
+    mu_run_test(test_reclaim);
+    mu_run_test(test_readers_writer);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
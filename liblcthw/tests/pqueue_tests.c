@@ -0,0 +1,156 @@
+#include "minunit.h"
+#include <lcthw/pqueue.h>
+
+#define MANY 5000
+
+static int values[MANY];
+
+static int cmp_int(const int *a, const int *b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+char *test_push_pop()
+{
+    PQueue *queue = PQueue_create((List_compare) cmp_int);
+    int i = 0;
+    int prev = -1;
+
+    mu_assert(queue != NULL, "Failed to create queue.");
+    mu_assert(PQueue_pop(queue) == NULL, "Pop of empty should be NULL.");
+    mu_assert(PQueue_peek(queue) == NULL, "Peek of empty should be NULL.");
+
+    for (i = 0; i < MANY; i++) {
+        values[i] = (i * 7919) % 1013;
+        mu_assert(PQueue_push(queue, &values[i]) != NULL, "Push failed.");
+    }
+    mu_assert(PQueue_count(queue) == MANY, "Wrong count after push.");
+    mu_assert(*(int *)PQueue_peek(queue) == 0, "Peek should be the min.");
+
+    for (i = 0; i < MANY; i++) {
+        int *val = PQueue_pop(queue);
+        mu_assert(val != NULL, "Popped NULL too soon.");
+        mu_assert(*val >= prev, "Popped out of order.");
+        prev = *val;
+    }
+
+    mu_assert(PQueue_count(queue) == 0, "Queue should be empty.");
+    PQueue_destroy(queue);
+    return NULL;
+}
+
+char *test_update()
+{
+    PQueue *queue = PQueue_create((List_compare) cmp_int);
+    PQueueNode *nodes[100];
+    int lowest = -1;
+    int highest = 1000;
+    int i = 0;
+
+    for (i = 0; i < 100; i++) {
+        values[i] = i * 10;
+        nodes[i] = PQueue_push(queue, &values[i]);
+    }
+
+    // decrease-key moves it to the front
+    mu_assert(PQueue_update(queue, nodes[70], &lowest) == 0, "Update failed.");
+    mu_assert(PQueue_peek(queue) == &lowest, "Decreased key isn't first.");
+    mu_assert(nodes[70]->value == &lowest, "Handle lost its value.");
+
+    // and increase works too, the old min drops to the back
+    mu_assert(PQueue_update(queue, nodes[70], &highest) == 0, "Update failed.");
+    mu_assert(PQueue_peek(queue) == &values[0], "Wrong min after increase.");
+
+    int prev = *(int *)PQueue_pop(queue);
+
+    // popped nodes are recycled, so the old handle must be rejected
+    mu_assert(PQueue_update(queue, nodes[0], &lowest) == -1,
+            "Update of a popped node should fail.");
+
+    for (i = 1; i < 100; i++) {
+        int *val = PQueue_pop(queue);
+        mu_assert(*val >= prev, "Popped out of order after update.");
+        prev = *val;
+    }
+    mu_assert(prev == highest, "Increased key should come out last.");
+
+    PQueue_destroy(queue);
+    return NULL;
+}
+
+char *test_spare_shrinks()
+{
+    PQueue *queue = PQueue_create((List_compare) cmp_int);
+    int i = 0;
+
+    for (i = 0; i < MANY; i++) {
+        values[i] = i;
+        PQueue_push(queue, &values[i]);
+    }
+
+    for (i = 0; i < MANY; i++) {
+        PQueue_pop(queue);
+    }
+
+    mu_assert(DArray_count(queue->spare) <= 64,
+            "A drained queue kept every node it ever had.");
+
+    PQueue_destroy(queue);
+    return NULL;
+}
+
+char *test_from_list()
+{
+    List *list = List_create();
+    int i = 0;
+    int prev = -1;
+
+    for (i = 0; i < MANY; i++) {
+        values[i] = MANY - i;
+        List_push(list, &values[i]);
+    }
+
+    PQueue *queue = PQueue_from_list(list, (List_compare) cmp_int);
+    mu_assert(queue != NULL, "Failed to heapify list.");
+    mu_assert(PQueue_count(queue) == MANY, "Wrong count from list.");
+    mu_assert(List_count(list) == MANY, "Heapify shouldn't touch the list.");
+
+    for (i = 0; i < MANY; i++) {
+        int *val = PQueue_pop(queue);
+        mu_assert(*val > prev, "Heapified queue popped out of order.");
+        prev = *val;
+    }
+
+    PQueue_destroy(queue);
+    List_destroy(list);
+    return NULL;
+}
+
+char *test_from_empty_list()
+{
+    List *list = List_create();
+
+    PQueue *queue = PQueue_from_list(list, (List_compare) cmp_int);
+    mu_assert(queue != NULL, "Failed to heapify an empty list.");
+    mu_assert(PQueue_count(queue) == 0, "Empty list should give an empty queue.");
+    mu_assert(PQueue_pop(queue) == NULL, "Empty queue should pop NULL.");
+
+    PQueue_destroy(queue);
+    List_destroy(list);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_push_pop);
+    mu_run_test(test_update);
+    mu_run_test(test_spare_shrinks);
+    mu_run_test(test_from_list);
+    mu_run_test(test_from_empty_list);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,203 @@
+#include "minunit.h"
+#include <lcthw/skiplist.h>
+
+#define MANY 5000
+
+static SkipList *list = NULL;
+static int values[MANY];
+
+typedef struct Keyed {
+    int key;
+    int order;
+} Keyed;
+
+static int cmp_int(const int *a, const int *b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+static int cmp_keyed(const Keyed * a, const Keyed * b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+char *test_create()
+{
+    list = SkipList_create((List_compare) cmp_int);
+    mu_assert(list != NULL, "Failed to create skiplist.");
+    mu_assert(SkipList_first(list) == NULL, "New list should be empty.");
+    mu_assert(SkipList_last(list) == NULL, "New list should be empty.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    SkipList_destroy(list);
+
+    return NULL;
+}
+
+char *test_insert()
+{
+    int i = 0;
+    int prev = -1;
+    int seen = 0;
+
+    for (i = 0; i < MANY; i++) {
+        // the even numbers up to 2 * MANY, in a scrambled order
+        values[i] = ((i * 7919) % MANY) * 2;
+        mu_assert(SkipList_insert(list, &values[i]) != NULL, "Insert failed.");
+    }
+    mu_assert(SkipList_count(list) == MANY, "Wrong count after insert.");
+
+    SKIPLIST_FOREACH(list, first, next, cur) {
+        mu_assert(*(int *)cur->value > prev, "Forward walk out of order.");
+        prev = *(int *)cur->value;
+        seen++;
+    }
+    mu_assert(seen == MANY, "Forward walk missed nodes.");
+
+    return NULL;
+}
+
+char *test_backward()
+{
+    int prev = 2 * MANY;
+    int seen = 0;
+
+    SKIPLIST_FOREACH(list, last, prev, cur) {
+        mu_assert(*(int *)cur->value < prev, "Backward walk out of order.");
+        prev = *(int *)cur->value;
+        seen++;
+    }
+    mu_assert(seen == MANY, "Backward walk missed nodes.");
+
+    return NULL;
+}
+
+char *test_find()
+{
+    int key = 42;
+    SkipListNode *node = SkipList_find(list, &key);
+    mu_assert(node != NULL && *(int *)node->value == 42, "Didn't find 42.");
+
+    key = 43;
+    mu_assert(SkipList_find(list, &key) == NULL, "Found an odd number.");
+
+    node = SkipList_lower_bound(list, &key);
+    mu_assert(node != NULL && *(int *)node->value == 44,
+            "lower_bound of 43 should be 44.");
+
+    key = -5;
+    node = SkipList_lower_bound(list, &key);
+    mu_assert(node == SkipList_first(list), "lower_bound below all is first.");
+
+    key = 2 * MANY;
+    mu_assert(SkipList_lower_bound(list, &key) == NULL,
+            "lower_bound past the end should be NULL.");
+
+    return NULL;
+}
+
+char *test_range()
+{
+    int low = 101;
+    int high = 201;
+    int count = 0;
+
+    SKIPLIST_FOREACH_FROM(SkipList_lower_bound(list, &low), next, cur) {
+        if (*(int *)cur->value > high) break;
+        count++;
+    }
+    mu_assert(count == 50, "Range 101..201 should hold 50 evens.");
+
+    return NULL;
+}
+
+char *test_delete()
+{
+    int i = 0;
+    int key = 43;
+
+    mu_assert(SkipList_delete(list, &key) == NULL, "Deleted a missing key.");
+
+    for (i = 0; i < MANY; i += 2) {
+        mu_assert(SkipList_delete(list, &values[i]) == &values[i],
+                "Delete returned the wrong value.");
+    }
+    mu_assert(SkipList_count(list) == MANY / 2, "Wrong count after delete.");
+
+    for (i = 0; i < MANY; i++) {
+        SkipListNode *node = SkipList_find(list, &values[i]);
+        mu_assert((node != NULL) == (i % 2 == 1), "Wrong find after delete.");
+    }
+
+    int prev = -1;
+    int seen = 0;
+    SKIPLIST_FOREACH(list, first, next, cur) {
+        mu_assert(*(int *)cur->value > prev, "Out of order after delete.");
+        mu_assert(cur->next[0] == NULL || cur->next[0]->prev == cur,
+                "prev links broken by delete.");
+        prev = *(int *)cur->value;
+        seen++;
+    }
+    mu_assert(seen == MANY / 2, "Walk after delete missed nodes.");
+
+    // the freed towers get reused
+    for (i = 0; i < MANY; i += 2) {
+        SkipList_insert(list, &values[i]);
+    }
+    mu_assert(SkipList_count(list) == MANY, "Wrong count after reinsert.");
+
+    return NULL;
+}
+
+char *test_duplicates()
+{
+    SkipList *dups = SkipList_create((List_compare) cmp_keyed);
+    Keyed items[300];
+    int i = 0;
+
+    for (i = 0; i < 300; i++) {
+        items[i].key = i % 3;
+        items[i].order = i;
+        SkipList_insert(dups, &items[i]);
+    }
+
+    Keyed *prev = NULL;
+    SKIPLIST_FOREACH(dups, first, next, cur) {
+        Keyed *item = cur->value;
+        if (prev != NULL && prev->key == item->key) {
+            mu_assert(prev->order < item->order, "Equal keys lost their order.");
+        }
+        prev = item;
+    }
+
+    Keyed key = {.key = 1 };
+    mu_assert(SkipList_find(dups, &key) == SkipList_lower_bound(dups, &key),
+            "find should give the first equal node.");
+    mu_assert(SkipList_delete(dups, &key) == &items[1],
+            "delete should take the first equal node.");
+
+    SkipList_destroy(dups);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_insert);
+    mu_run_test(test_backward);
+    mu_run_test(test_find);
+    mu_run_test(test_range);
+    mu_run_test(test_delete);
+    mu_run_test(test_destroy);
+    mu_run_test(test_duplicates);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,146 @@
+#include "minunit.h"
+#include <lcthw/threadpool.h>
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+#define NTASKS 10000
+#define NCHILDREN 50
+
+static ThreadPool *pool = NULL;
+static atomic_int ran = 0;
+static char seen[NTASKS];
+
+static void mark(void *arg)
+{
+    seen[(intptr_t)arg] = 1;
+    atomic_fetch_add(&ran, 1);
+}
+
+// submits more tasks from inside a task, they go on this worker's deque
+static void spawn(void *arg)
+{
+    intptr_t base = (intptr_t)arg;
+    int i = 0;
+
+    for (i = 0; i < NCHILDREN; i++) {
+        ThreadPool_submit(pool, mark, (void *)(base + i));
+    }
+}
+
+char *test_create()
+{
+    pool = ThreadPool_create(4);
+    mu_assert(pool != NULL, "Failed to create pool.");
+    mu_assert(ThreadPool_threads(pool) == 4, "Wrong thread count.");
+
+    mu_assert(ThreadPool_create(0) == NULL, "Should reject 0 threads.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    ThreadPool_destroy(pool);
+
+    return NULL;
+}
+
+char *test_submit_wait()
+{
+    intptr_t i = 0;
+
+    ThreadPool_wait(pool);
+
+    for (i = 0; i < NTASKS; i++) {
+        mu_assert(ThreadPool_submit(pool, mark, (void *)i) == 0,
+                "Submit failed.");
+    }
+
+    ThreadPool_wait(pool);
+    mu_assert(atomic_load(&ran) == NTASKS, "Wait returned early.");
+
+    for (i = 0; i < NTASKS; i++) {
+        mu_assert(seen[i], "A task never ran.");
+    }
+
+    return NULL;
+}
+
+char *test_nested_submit()
+{
+    intptr_t i = 0;
+
+    memset(seen, 0, sizeof(seen));
+    atomic_store(&ran, 0);
+
+    for (i = 0; i < NTASKS / NCHILDREN; i++) {
+        ThreadPool_submit(pool, spawn, (void *)(i * NCHILDREN));
+    }
+
+    ThreadPool_wait(pool);
+    mu_assert(atomic_load(&ran) == NTASKS, "Lost nested tasks.");
+
+    for (i = 0; i < NTASKS; i++) {
+        mu_assert(seen[i], "A nested task never ran.");
+    }
+
+    return NULL;
+}
+
+char *test_run_one()
+{
+    ThreadPool *one = ThreadPool_create(1);
+    intptr_t i = 0;
+
+    memset(seen, 0, sizeof(seen));
+    atomic_store(&ran, 0);
+
+    // the caller helps, whatever it takes the worker doesn't
+    for (i = 0; i < NTASKS; i++) {
+        ThreadPool_submit(one, mark, (void *)i);
+    }
+
+    while (ThreadPool_run_one(one)) {
+    }
+
+    ThreadPool_wait(one);
+    mu_assert(atomic_load(&ran) == NTASKS, "Lost tasks helping out.");
+    mu_assert(ThreadPool_run_one(one) == 0, "Nothing should be left to run.");
+
+    ThreadPool_destroy(one);
+    return NULL;
+}
+
+char *test_destroy_finishes()
+{
+    ThreadPool *two = ThreadPool_create(2);
+    intptr_t i = 0;
+
+    atomic_store(&ran, 0);
+
+    for (i = 0; i < NTASKS; i++) {
+        ThreadPool_submit(two, mark, (void *)i);
+    }
+
+    ThreadPool_destroy(two);
+    mu_assert(atomic_load(&ran) == NTASKS, "Destroy dropped queued tasks.");
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_submit_wait);
+    mu_run_test(test_nested_submit);
+    mu_run_test(test_run_one);
+    mu_run_test(test_destroy_finishes);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
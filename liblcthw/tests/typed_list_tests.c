@@ -0,0 +1,111 @@
+#include "minunit.h"
+#include <lcthw/typed_list.h>
+
+typedef struct Point {
+    int x;
+    int y;
+} Point;
+
+#define CMP_POINT(A, B) (((A)->x > (B)->x) - ((A)->x < (B)->x))
+
+DEFINE_TYPED_LIST(IntList, int)
+DEFINE_TYPED_LIST_SORT(IntList, IntList_sort, LIST_CMP_INT)
+
+DEFINE_TYPED_LIST(PointList, Point)
+DEFINE_TYPED_LIST_SORT(PointList, PointList_sort, CMP_POINT)
+
+char *test_push_pop()
+{
+    IntList *list = IntList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+
+    mu_assert(IntList_push(list, 1) == 0, "Push failed.");
+    IntList_push(list, 2);
+    IntList_unshift(list, 0);
+    mu_assert(list->count == 3, "Wrong count after push.");
+    mu_assert(list->first->value == 0 && list->last->value == 2,
+            "Wrong first or last.");
+
+    mu_assert(IntList_pop(list) == 2, "Wrong value on pop.");
+    mu_assert(IntList_shift(list) == 0, "Wrong value on shift.");
+    mu_assert(IntList_shift(list) == 1, "Wrong value on shift.");
+    mu_assert(list->count == 0 && list->first == NULL && list->last == NULL,
+            "List should be empty.");
+    mu_assert(IntList_pop(list) == 0, "Pop of empty should give zero.");
+
+    IntList_destroy(list);
+    return NULL;
+}
+
+char *test_remove_foreach()
+{
+    IntList *list = IntList_create();
+    int i = 0;
+    int total = 0;
+
+    for (i = 0; i < 10; i++) {
+        IntList_push(list, i);
+    }
+
+    mu_assert(IntList_remove(list, list->first->next) == 1,
+            "Wrong value on remove.");
+
+    TYPED_LIST_FOREACH(IntList, list, first, next, cur) {
+        total += cur->value;
+    }
+    mu_assert(total == 44, "Foreach gave the wrong values.");
+
+    IntList_destroy(list);
+    return NULL;
+}
+
+char *test_sort()
+{
+    IntList *ints = IntList_create();
+    PointList *points = PointList_create();
+    int i = 0;
+
+    for (i = 0; i < 1000; i++) {
+        IntList_push(ints, (i * 7919) % 1009 - 500);
+        PointList_push(points, (Point) { (i * 7919) % 37, i });
+    }
+
+    mu_assert(IntList_sort(ints) == ints, "Should sort in place.");
+    PointList_sort(points);
+    mu_assert(ints->count == 1000 && points->count == 1000,
+            "Sort lost nodes.");
+
+    TYPED_LIST_FOREACH(IntList, ints, first, next, cur) {
+        if (cur->next) {
+            mu_assert(cur->value <= cur->next->value, "Ints not sorted.");
+            mu_assert(cur->next->prev == cur, "Broken prev link.");
+        }
+    }
+
+    // the points came in with rising y, equal x has to keep that order
+    PointListNode *node = points->first;
+    for (; node->next != NULL; node = node->next) {
+        mu_assert(node->value.x < node->next->value.x ||
+                (node->value.x == node->next->value.x &&
+                 node->value.y < node->next->value.y),
+                "Points not sorted stably.");
+    }
+    mu_assert(points->last == node, "Wrong last after sort.");
+
+    IntList_destroy(ints);
+    PointList_destroy(points);
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_push_pop);
+    mu_run_test(test_remove_foreach);
+    mu_run_test(test_sort);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);
@@ -0,0 +1,249 @@
+#include "minunit.h"
+#include <lcthw/ulist.h>
+#include <assert.h>
+
+static UList *list = NULL;
+char *test1 = "test1 data";
+char *test2 = "test2 data";
+char *test3 = "test3 data";
+
+char *test_create()
+{
+    list = UList_create();
+    mu_assert(list != NULL, "Failed to create list.");
+
+    return NULL;
+}
+
+char *test_destroy()
+{
+    UList_destroy(list);
+
+    return NULL;
+}
+
+char *test_push_pop()
+{
+    UList_push(list, test1);
+    mu_assert(UList_last(list) == test1, "Wrong last value.");
+
+    UList_push(list, test2);
+    mu_assert(UList_last(list) == test2, "Wrong last value");
+
+    UList_push(list, test3);
+    mu_assert(UList_last(list) == test3, "Wrong last value.");
+    mu_assert(UList_count(list) == 3, "Wrong count on push.");
+
+    char *val = UList_pop(list);
+    mu_assert(val == test3, "Wrong value on pop.");
+
+    val = UList_pop(list);
+    mu_assert(val == test2, "Wrong value on pop.");
+
+    val = UList_pop(list);
+    mu_assert(val == test1, "Wrong value on pop.");
+    mu_assert(UList_count(list) == 0, "Wrong count after pop.");
+    mu_assert(list->first == NULL && list->last == NULL,
+            "Empty chunk was not freed.");
+
+    return NULL;
+}
+
+char *test_unshift()
+{
+    UList_unshift(list, test1);
+    mu_assert(UList_first(list) == test1, "Wrong first value.");
+
+    UList_unshift(list, test2);
+    mu_assert(UList_first(list) == test2, "Wrong first value");
+
+    UList_unshift(list, test3);
+    mu_assert(UList_first(list) == test3, "Wrong last value.");
+    mu_assert(UList_count(list) == 3, "Wrong count on unshift.");
+
+    return NULL;
+}
+
+char *test_remove()
+{
+    char *val = UList_remove(list, list->first, 1);
+    mu_assert(val == test2, "Wrong removed element.");
+    mu_assert(UList_count(list) == 2, "Wrong count after remove.");
+    mu_assert(UList_first(list) == test3, "Wrong first after remove.");
+    mu_assert(UList_last(list) == test1, "Wrong last after remove.");
+    mu_assert(UList_remove(list, list->first, 5) == NULL,
+            "Should not remove past the end of a chunk.");
+
+    return NULL;
+}
+
+char *test_shift()
+{
+    mu_assert(UList_count(list) != 0, "Wrong count before shift.");
+
+    char *val = UList_shift(list);
+    mu_assert(val == test3, "Wrong value on shift.");
+
+    val = UList_shift(list);
+    mu_assert(val == test1, "Wrong value on shift.");
+    mu_assert(UList_count(list) == 0, "Wrong count after shift.");
+
+    return NULL;
+}
+
+char *test_many_chunks()
+{
+    int values[100];
+    int i = 0;
+
+    // both ends have to spill into new chunks
+    for (i = 0; i < 50; i++) {
+        values[i] = i;
+        UList_push(list, &values[i]);
+    }
+    for (i = 50; i < 100; i++) {
+        values[i] = i;
+        UList_unshift(list, &values[i]);
+    }
+
+    mu_assert(UList_count(list) == 100, "Wrong count across chunks.");
+    mu_assert(*(int *)UList_first(list) == 99, "Wrong first across chunks.");
+    mu_assert(*(int *)UList_last(list) == 49, "Wrong last across chunks.");
+
+    i = 0;
+    ULIST_FOREACH(list, chunk, j) {
+        int expect = i < 50 ? 99 - i : i - 50;
+        mu_assert(*(int *)chunk->values[j] == expect, "Wrong iteration order.");
+        i++;
+    }
+    mu_assert(i == 100, "Iteration missed values.");
+
+    for (i = 0; i < 100; i++) {
+        mu_assert(UList_shift(list) != NULL, "Shift across chunks failed.");
+    }
+    mu_assert(list->first == NULL, "Chunks left after draining.");
+
+    return NULL;
+}
+
+char *test_churn_merges()
+{
+    int values[ULIST_CHUNK * 64];
+    int n = ULIST_CHUNK * 64;
+    int chunks = 0;
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        values[i] = i;
+        UList_push(list, &values[i]);
+    }
+
+    // keep one value in every ULIST_CHUNK, a remove can free or merge
+    // chunks so each one is found again by position
+    int pos = 0;
+    for (i = 0; i < n; i++) {
+        if (i % ULIST_CHUNK == 0) {
+            pos++;
+            continue;
+        }
+
+        UListChunk *at = list->first;
+        int index = pos;
+        while (index >= at->count) {
+            index -= at->count;
+            at = at->next;
+        }
+        mu_assert(UList_remove(list, at, index) == &values[i],
+                "Removed the wrong value.");
+    }
+    mu_assert(UList_count(list) == n / ULIST_CHUNK, "Wrong count after churn.");
+
+    UListChunk *chunk = NULL;
+    for (chunk = list->first; chunk != NULL; chunk = chunk->next) {
+        chunks++;
+    }
+    // without merging that'd be one value in each of 64 chunks
+    mu_assert(chunks <= 2 * UList_count(list) / (ULIST_CHUNK / 2) + 1,
+            "Underfull chunks weren't merged.");
+
+    int last = -1;
+    ULIST_FOREACH(list, c, j) {
+        mu_assert(*(int *)c->values[j] > last, "Merge broke the order.");
+        last = *(int *)c->values[j];
+    }
+
+    while (UList_count(list) > 0) {
+        UList_pop(list);
+    }
+    mu_assert(list->first == NULL, "Chunks left after draining.");
+
+    return NULL;
+}
+
+int cmp_int(const int *a, const int *b)
+{
+    return *a - *b;
+}
+
+int is_sorted(UList * sorted)
+{
+    int *last = NULL;
+
+    ULIST_FOREACH(sorted, chunk, i) {
+        int *cur = chunk->values[i];
+        if (last != NULL && *last > *cur) {
+            return 0;
+        }
+        last = cur;
+    }
+
+    return 1;
+}
+
+char *test_sorts()
+{
+    int values[300];
+    int i = 0;
+
+    for (i = 0; i < 300; i++) {
+        values[i] = (i * 7919) % 301;
+        UList_push(list, &values[i]);
+    }
+
+    mu_assert(UList_merge_sort(list, (List_compare) cmp_int) == 0,
+            "Merge sort failed.");
+    mu_assert(is_sorted(list), "Not sorted after merge sort.");
+    mu_assert(UList_count(list) == 300, "Merge sort lost values.");
+
+    for (i = 0; i < 300; i++) {
+        UList_pop(list);
+    }
+    for (i = 0; i < 40; i++) {
+        UList_unshift(list, &values[i]);
+    }
+
+    mu_assert(UList_bubble_sort(list, (List_compare) cmp_int) == 0,
+            "Bubble sort failed.");
+    mu_assert(is_sorted(list), "Not sorted after bubble sort.");
+
+    return NULL;
+}
+
+char *all_tests()
+{
+    mu_suite_start();
+
+    mu_run_test(test_create);
+    mu_run_test(test_push_pop);
+    mu_run_test(test_unshift);
+    mu_run_test(test_remove);
+    mu_run_test(test_shift);
+    mu_run_test(test_many_chunks);
+    mu_run_test(test_churn_merges);
+    mu_run_test(test_sorts);
+    mu_run_test(test_destroy);
+
+    return NULL;
+}
+
+RUN_TESTS(all_tests);